@@ -7,7 +7,7 @@ import threading
 import time
 from typing import List, Optional, Callable
 from queue import Queue
-from .Protocol import Protocol, MessageType
+from .Protocol import Protocol, MessageType, STATE_FIELDS
 
 class ClientManager:
     def __init__(self):
@@ -31,6 +31,7 @@ class ClientManager:
         # Client info
         self.number: Optional[int] = None
         self.nickname: Optional[str] = None
+        self.session_token: Optional[str] = None  # Token relace z AUTHORIZE pro reconnect
         self.last_packet_id: int = 0
         
         # Threads
@@ -53,6 +54,11 @@ class ClientManager:
         # Messages
         self.msgCounter = 0
         self.error_msg = ""
+
+        # Stav hry skládaný ze STATE_DELTA
+        self.state_fields: List[str] = [""] * STATE_FIELDS
+        self.state_version = 0
+        self.state_resync = False  # Rozdíl nenavázal – čekáme na snímek (baseVersion 0)
         
     # ============================================================
     # CONNECT - S TIMEOUTEM
@@ -130,7 +136,7 @@ class ClientManager:
             if self.nickname:
                 if reconnect:
                     self.send_message(MessageType.RECONNECT, 
-                                    [self.nickname, str(self.last_packet_id)])
+                                    [self.session_token or self.nickname, str(self.last_packet_id)])
                     print(f"🔄 Pokus o reconnect: {self.nickname}")
             
             # 🆕 ČEKÁME NA WELCOME/READY ZPRÁVU S TIMEOUTEM
@@ -187,11 +193,20 @@ class ClientManager:
             if msg_type == MessageType.PONG:
                 self.last_pong = time.time()
                 return
+
+            # STATE_DELTA složíme do plného STATE, zbytek klienta rozdíly nezná
+            if msg_type == MessageType.STATE_DELTA:
+                fields = self._apply_state_delta(fields)
+                if fields is None:
+                    return
+                msg_type = MessageType.STATE
             
             if msg_type in (MessageType.WELCOME, MessageType.AUTHORIZE):
                 print("✅ Přijato potvrzení od serveru")
                 self.welcome_received.set()  # 🆕 Signalizuj úspěch
                 self.connected = True
+                if msg_type == MessageType.AUTHORIZE and fields and fields[0]:
+                    self.session_token = fields[0]
             
             # RECONNECT také signalizuje úspěch
             elif msg_type == MessageType.RECONNECT:
@@ -223,6 +238,46 @@ class ClientManager:
             if self.msgCounter >= 3:
                 self.disconnect(msg="Server posílá nesprávné zprávy!")
     
+    def _apply_state_delta(self, fields: List[str]) -> Optional[List[str]]:
+        """Aplikuje STATE_DELTA (version|baseVersion|index=hodnota|...) a vrátí plný STATE.
+
+        Rozdíl, který nenavazuje na naši verzi, se nepoužije (vrací None) – zůstává
+        poslední platný stav, dokud nepřijde snímek (baseVersion 0).
+        """
+        version, base = int(fields[0]), int(fields[1])
+
+        if base == 0:
+            self.state_fields = [""] * STATE_FIELDS
+            self.state_resync = False
+        elif self.state_resync:
+            return None
+        elif base != self.state_version:
+            self.state_resync = True
+            self._request_state_resync()
+            return None
+
+        for entry in fields[2:]:
+            index, _, value = entry.partition("=")
+            self.state_fields[int(index)] = value
+        self.state_version = version
+
+        # Stejná pole jako plný STATE ze serveru
+        state = self.state_fields[0:3]
+        if state[2] and int(state[2]):
+            state += self.state_fields[3:6]
+            if self.state_fields[5] and int(self.state_fields[5]):
+                state += self.state_fields[6:8]
+        return state
+
+    def _request_state_resync(self):
+        """Vyžádá snímek stavu – server ho delta klientovi posílá po reconnectu."""
+        # Shozené spojení zachytí listening thread a spustí běžný auto-reconnect
+        if self.sock:
+            try:
+                self.sock.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
+
     # ============================================================
     # DISCONNECT - Vylepšený
     # ============================================================
@@ -24,10 +24,17 @@ class MessageType(IntEnum):
     RESET = 18
     PING = 19
     PONG = 20
+    STATE_DELTA = 21
 
 DELIMITER = '|'
 TERMINATOR = '\n'
 
+# Schopnosti ohlašované v CONNECT (pole za přezdívkou)
+CAPABILITY_DELTA_STATE = "delta"
+
+# Počet polí plného STATE: state|stateChanged|gameStarted|mode|trumph|isPlayedCards|cards|change_trick
+STATE_FIELDS = 8
+
 class Protocol:
     """Binární protokol: [ 2B Velikost | 1B Packet ID | 1B Client Number | 1B Type | Data (oddělené '|') ]"""
     
@@ -5,6 +5,7 @@ from enum import Enum
 import threading
 from .View.GuiManager import GuiManager
 from .Client.ClientManager import ClientManager, MessageType
+from .Client.Protocol import CAPABILITY_DELTA_STATE
 from .GameManager import GameManager
 from .Game.Game import Game
 from .View.Validator import InputValidator
@@ -184,7 +185,7 @@ class Gui:
         self.gameManager = GameManager(self.required_players, self.client, self.guiManager)
         self.set_state(GameState.CONNECTING)
         
-        self.client.send_message(MessageType.CONNECT, [self.client.nickname])
+        self.client.send_message(MessageType.CONNECT, [self.client.nickname, CAPABILITY_DELTA_STATE])
         print(f"📤 Posílám nickname: {self.client.nickname}")
     
     def handle_wait_lobby(self, data: list):
@@ -0,0 +1,354 @@
+#include "AdminServer.hpp"
+#include "LobbyManager.hpp"
+#include "Metrics.hpp"
+#include "NetworkManager.hpp"
+#include "SessionPool.hpp"
+#include "Logger.hpp"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    // Neznámé typy (index 0) se ve výstupu vynechávají
+    std::string typeName(size_t type) {
+        return std::string(Protocol::messageTypeName(static_cast<Protocol::MessageType>(type)));
+    }
+
+    std::string seconds(uint64_t nanoseconds) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.9f", static_cast<double>(nanoseconds) / 1e9);
+        return text;
+    }
+
+    // Řádek Promethea: name{labels} value
+    void appendSample(std::string& out, const std::string& name, const std::string& labels,
+                      const std::string& value) {
+        out += name;
+        if (!labels.empty()) {
+            out += "{" + labels + "}";
+        }
+        out += " " + value + "\n";
+    }
+
+    void appendHeader(std::string& out, const std::string& name, const char* type, const char* help) {
+        out += "# HELP " + name + " " + help + "\n";
+        out += "# TYPE " + name + " " + type + "\n";
+    }
+
+    // Jedna hodnota za každou místnost s popiskem lobby="id"
+    template <typename Getter>
+    void appendLobbyGauge(std::string& out, const std::vector<LobbySummary>& lobbies,
+                          const std::string& name, const char* help, Getter getter) {
+        appendHeader(out, name, "gauge", help);
+        for (const auto& lobby : lobbies) {
+            appendSample(out, name, "lobby=\"" + std::to_string(lobby.id) + "\"", std::to_string(getter(lobby)));
+        }
+    }
+
+    std::string httpResponse(int status, const char* reason, const char* contentType,
+                             const std::string& body) {
+        return "HTTP/1.0 " + std::to_string(status) + " " + reason + "\r\n" +
+               "Content-Type: " + contentType + "\r\n" +
+               "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+               "Connection: close\r\n\r\n" + body;
+    }
+}
+
+AdminServer::AdminServer(int port, LobbyManager* lobbyManager, SessionPool* sessionPool, Metrics* metrics)
+    : port(port), lobbyManager(lobbyManager), sessionPool(sessionPool), metrics(metrics),
+      listenSocket(-1), running(false) {}
+
+AdminServer::~AdminServer() {
+    stop();
+}
+
+bool AdminServer::start() {
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        LOG_ERROR("❌ Admin rozhraní: nelze vytvořit socket");
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Jen loopback – rozhraní nemá autentizaci
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenSocket, 8) < 0) {
+        LOG_ERROR("❌ Admin rozhraní: nelze naslouchat na 127.0.0.1:{} ({})", port, std::strerror(errno));
+        close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    running = true;
+    worker = std::thread(&AdminServer::run, this);
+    LOG_INFO("📈 Admin rozhraní na http://127.0.0.1:{} (/stats, /metrics)", port);
+    return true;
+}
+
+void AdminServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    // shutdown probudí blokující accept
+    shutdown(listenSocket, SHUT_RDWR);
+    close(listenSocket);
+    listenSocket = -1;
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+    LOG_INFO("🛑 Admin rozhraní zastaveno");
+}
+
+// ============================================================
+// OBSLUHA DOTAZŮ
+// ============================================================
+void AdminServer::run() {
+    while (running) {
+        int client = accept(listenSocket, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        serve(client);
+        close(client);
+    }
+}
+
+void AdminServer::serve(int socket) {
+    timeval timeout{REQUEST_TIMEOUT_SECONDS, 0};
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Stačí první řádek požadavku, hlavičky se jen dočtou
+    std::string request;
+    char buffer[512];
+    while (request.find("\r\n\r\n") == std::string::npos && request.find("\n\n") == std::string::npos) {
+        ssize_t received = recv(socket, buffer, sizeof(buffer), 0);
+        if (received <= 0 || request.size() + received > MAX_REQUEST_SIZE) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    std::string line = request.substr(0, request.find_first_of("\r\n"));
+    size_t methodEnd = line.find(' ');
+    size_t pathEnd = line.find(' ', methodEnd + 1);
+    std::string method = line.substr(0, methodEnd);
+    std::string path = methodEnd == std::string::npos ? "" : line.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    path = path.substr(0, path.find('?'));
+
+    std::string response;
+    if (method != "GET") {
+        response = httpResponse(405, "Method Not Allowed", "text/plain", "Povolena je jen metoda GET\n");
+    } else if (path == "/metrics") {
+        response = httpResponse(200, "OK", "text/plain; version=0.0.4", renderPrometheus());
+    } else if (path == "/" || path == "/stats") {
+        response = httpResponse(200, "OK", "application/json", renderJson());
+    } else {
+        response = httpResponse(404, "Not Found", "text/plain", "Dostupné cesty: /stats, /metrics\n");
+    }
+
+    size_t total = 0;
+    while (total < response.size()) {
+        ssize_t sent = send(socket, response.data() + total, response.size() - total, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(sent);
+    }
+}
+
+// ============================================================
+// SNÍMKY
+// ============================================================
+std::string AdminServer::renderJson() const {
+    std::vector<LobbySummary> lobbies = lobbyManager->getSummaries();
+    Metrics::Snapshot snapshot = metrics->snapshot();
+
+    int connected = 0;
+    int active = 0;
+    for (const auto& lobby : lobbies) {
+        connected += lobby.connected;
+        active += lobby.active;
+    }
+
+    std::string out = "{";
+    out += "\"lobbies\":{\"created\":" + std::to_string(lobbies.size()) +
+           ",\"max\":" + std::to_string(lobbyManager->getMaxLobbies()) +
+           ",\"open_seats\":" + std::to_string(snapshot.openSeats) +
+           ",\"occupied_seats\":" + std::to_string(snapshot.occupiedSeats) + "},";
+    out += "\"sessions\":{\"in_use\":" + std::to_string(sessionPool->getInUse()) +
+           ",\"capacity\":" + std::to_string(sessionPool->getCapacity()) + "},";
+    out += "\"connections\":{\"connected\":" + std::to_string(connected) +
+           ",\"active\":" + std::to_string(active) + "},";
+
+    out += "\"lobby_list\":[";
+    for (size_t i = 0; i < lobbies.size(); i++) {
+        const LobbySummary& lobby = lobbies[i];
+        if (i > 0) {
+            out += ",";
+        }
+        out += "{\"id\":" + std::to_string(lobby.id) +
+               ",\"required\":" + std::to_string(lobby.requiredPlayers) +
+               ",\"connected\":" + std::to_string(lobby.connected) +
+               ",\"active\":" + std::to_string(lobby.active) +
+               ",\"authorized\":" + std::to_string(lobby.authorized) +
+               ",\"open_seats\":" + std::to_string(lobby.openSeats) +
+               ",\"game_started\":" + (lobby.gameStarted ? "true" : "false") +
+               ",\"hibernated\":" + (lobby.hibernated ? "true" : "false") +
+               ",\"game_state\":" + std::to_string(lobby.gameState) +
+               ",\"active_player\":" + std::to_string(lobby.activePlayer) +
+               ",\"inbox_depth\":" + std::to_string(lobby.inboxDepth) +
+               ",\"inbox_peak\":" + std::to_string(lobby.inboxPeak) +
+               ",\"rejected\":" + std::to_string(lobby.rejected) +
+               ",\"version\":" + std::to_string(lobby.version) + "}";
+    }
+    out += "],";
+
+    out += "\"messages\":{";
+    bool first = true;
+    for (size_t type = 1; type < Metrics::MESSAGE_TYPES; type++) {
+        const Metrics::MessageStats& stats = snapshot.messages[type];
+        if (stats.in == 0 && stats.out == 0 && stats.handler.count == 0) {
+            continue;
+        }
+        if (!first) {
+            out += ",";
+        }
+        first = false;
+
+        const Metrics::Histogram& handler = stats.handler;
+        out += "\"" + typeName(type) + "\":{\"in\":" + std::to_string(stats.in) +
+               ",\"out\":" + std::to_string(stats.out) +
+               ",\"bytes_in\":" + std::to_string(stats.bytesIn) +
+               ",\"bytes_out\":" + std::to_string(stats.bytesOut) +
+               ",\"handler_ns\":{\"count\":" + std::to_string(handler.count) +
+               ",\"sum\":" + std::to_string(handler.sum) +
+               ",\"p50\":" + std::to_string(handler.percentile(50)) +
+               ",\"p90\":" + std::to_string(handler.percentile(90)) +
+               ",\"p99\":" + std::to_string(handler.percentile(99)) +
+               ",\"max\":" + std::to_string(handler.max) + "}}";
+    }
+    out += "},";
+
+    out += "\"validation_failures\":{";
+    for (size_t reason = 1; reason < Metrics::VALIDATION_RESULTS; reason++) {
+        if (reason > 1) {
+            out += ",";
+        }
+        auto result = static_cast<NetworkManager::ValidationResult>(reason);
+        out += "\"" + std::string(NetworkManager::validationResultName(result)) + "\":" +
+               std::to_string(snapshot.validationFailures[reason]);
+    }
+    out += "},";
+
+    out += "\"reconnects\":{\"succeeded\":" + std::to_string(snapshot.reconnects) +
+           ",\"failed\":" + std::to_string(snapshot.reconnectFailures) + "}";
+    out += "}\n";
+    return out;
+}
+
+std::string AdminServer::renderPrometheus() const {
+    std::vector<LobbySummary> lobbies = lobbyManager->getSummaries();
+    Metrics::Snapshot snapshot = metrics->snapshot();
+    std::string out;
+
+    appendHeader(out, "ups_lobbies", "gauge", "Vytvořené místnosti");
+    appendSample(out, "ups_lobbies", "", std::to_string(lobbies.size()));
+    appendHeader(out, "ups_lobbies_max", "gauge", "Horní mez počtu místností");
+    appendSample(out, "ups_lobbies_max", "", std::to_string(lobbyManager->getMaxLobbies()));
+    appendHeader(out, "ups_seats", "gauge", "Místa ve vytvořených místnostech");
+    appendSample(out, "ups_seats", "state=\"open\"", std::to_string(snapshot.openSeats));
+    appendSample(out, "ups_seats", "state=\"occupied\"", std::to_string(snapshot.occupiedSeats));
+    appendHeader(out, "ups_sessions", "gauge", "Sloty relací");
+    appendSample(out, "ups_sessions", "state=\"in_use\"", std::to_string(sessionPool->getInUse()));
+    appendSample(out, "ups_sessions", "state=\"capacity\"", std::to_string(sessionPool->getCapacity()));
+
+    // Souhrny místností
+    appendLobbyGauge(out, lobbies, "ups_lobby_connected", "Připojení klienti místnosti",
+                     [](const LobbySummary& lobby) { return lobby.connected; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_active", "Aktivní hráči místnosti",
+                     [](const LobbySummary& lobby) { return lobby.active; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_open_seats", "Volná místa místnosti",
+                     [](const LobbySummary& lobby) { return lobby.openSeats; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_game_started", "Hra v místnosti běží",
+                     [](const LobbySummary& lobby) { return lobby.gameStarted ? 1 : 0; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_hibernated", "Místnost je uspaná",
+                     [](const LobbySummary& lobby) { return lobby.hibernated ? 1 : 0; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_game_state", "Stav hry (-1 = žádná hra)",
+                     [](const LobbySummary& lobby) { return lobby.gameState; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_inbox_depth", "Čekající úlohy ve schránce",
+                     [](const LobbySummary& lobby) { return lobby.inboxDepth; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_inbox_peak", "Nejvyšší hloubka schránky",
+                     [](const LobbySummary& lobby) { return lobby.inboxPeak; });
+    appendLobbyGauge(out, lobbies, "ups_lobby_inbox_rejected", "Zprávy odmítnuté plnou schránkou",
+                     [](const LobbySummary& lobby) { return lobby.rejected; });
+
+    // Zprávy podle typu
+    struct MessageCounter {
+        const char* name;
+        const char* help;
+        uint64_t Metrics::MessageStats::*field;
+    };
+    const MessageCounter counters[] = {
+        {"ups_messages_received_total", "Přijaté zprávy", &Metrics::MessageStats::in},
+        {"ups_messages_sent_total", "Odeslané zprávy", &Metrics::MessageStats::out},
+        {"ups_bytes_received_total", "Přijaté bajty", &Metrics::MessageStats::bytesIn},
+        {"ups_bytes_sent_total", "Odeslané bajty", &Metrics::MessageStats::bytesOut},
+    };
+    for (const auto& counter : counters) {
+        appendHeader(out, counter.name, "counter", counter.help);
+        for (size_t type = 1; type < Metrics::MESSAGE_TYPES; type++) {
+            appendSample(out, counter.name, "type=\"" + typeName(type) + "\"",
+                         std::to_string(snapshot.messages[type].*counter.field));
+        }
+    }
+
+    appendHeader(out, "ups_handler_latency_seconds", "summary", "Doba zpracování zprávy ve strandu");
+    for (size_t type = 1; type < Metrics::MESSAGE_TYPES; type++) {
+        const Metrics::Histogram& handler = snapshot.messages[type].handler;
+        if (handler.count == 0) {
+            continue;
+        }
+        std::string label = "type=\"" + typeName(type) + "\"";
+        for (double quantile : {0.5, 0.9, 0.99}) {
+            char text[16];
+            std::snprintf(text, sizeof(text), "%g", quantile);
+            appendSample(out, "ups_handler_latency_seconds", label + ",quantile=\"" + text + "\"",
+                         seconds(handler.percentile(quantile * 100)));
+        }
+        appendSample(out, "ups_handler_latency_seconds_sum", label, seconds(handler.sum));
+        appendSample(out, "ups_handler_latency_seconds_count", label, std::to_string(handler.count));
+    }
+
+    appendHeader(out, "ups_validation_failures_total", "counter", "Odmítnuté zprávy podle důvodu");
+    for (size_t reason = 1; reason < Metrics::VALIDATION_RESULTS; reason++) {
+        auto result = static_cast<NetworkManager::ValidationResult>(reason);
+        appendSample(out, "ups_validation_failures_total",
+                     "reason=\"" + std::string(NetworkManager::validationResultName(result)) + "\"",
+                     std::to_string(snapshot.validationFailures[reason]));
+    }
+
+    appendHeader(out, "ups_reconnects_total", "counter", "Pokusy o reconnect");
+    appendSample(out, "ups_reconnects_total", "result=\"succeeded\"", std::to_string(snapshot.reconnects));
+    appendSample(out, "ups_reconnects_total", "result=\"failed\"", std::to_string(snapshot.reconnectFailures));
+    return out;
+}
@@ -0,0 +1,45 @@
+#ifndef ADMIN_SERVER_HPP
+#define ADMIN_SERVER_HPP
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+class LobbyManager;
+class SessionPool;
+class Metrics;
+
+// Administrátorské rozhraní na loopbacku (jednoduché HTTP/1.0, jedno vlákno).
+//   GET /stats   – JSON: místnosti, místa, stav her, spojení, schránky, metriky
+//   GET /metrics – Prometheus text
+// Snímek se skládá ze souhrnů místností zveřejněných strandy (SeqLock)
+// a z lock-free čítačů – dotaz nebere žádný zámek herní cesty.
+class AdminServer {
+public:
+    AdminServer(int port, LobbyManager* lobbyManager, SessionPool* sessionPool, Metrics* metrics);
+    ~AdminServer();
+
+    bool start(); // Otevře socket na 127.0.0.1:port a spustí vlákno
+    void stop();  // Zavře socket a počká na vlákno
+
+    std::string renderJson() const;       // Snímek ve formátu JSON
+    std::string renderPrometheus() const; // Snímek v textovém formátu Promethea
+
+private:
+    static constexpr int REQUEST_TIMEOUT_SECONDS = 1; // Jak dlouho čekat na hlavičku požadavku
+    static constexpr size_t MAX_REQUEST_SIZE = 4096;  // Delší hlavička se odmítne
+
+    int port;
+    LobbyManager* lobbyManager;
+    SessionPool* sessionPool;
+    Metrics* metrics;
+
+    int listenSocket;
+    std::atomic<bool> running;
+    std::thread worker;
+
+    void run();                 // Smyčka přijímání dotazů
+    void serve(int socket);     // Obslouží jeden dotaz a zavře spojení
+};
+
+#endif // ADMIN_SERVER_HPP
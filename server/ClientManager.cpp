@@ -1,13 +1,17 @@
 #include "ClientManager.hpp"
 #include "NetworkManager.hpp"
-#include <iostream>
+#include "SessionPool.hpp"
+#include "Strand.hpp"
+#include "Logger.hpp"
 #include <algorithm>
 #include <unistd.h>
 #include <sys/socket.h>
 
-ClientManager::ClientManager(int requiredPlayers, NetworkManager* networkManager)
-    : networkManager(networkManager), requiredPlayers(requiredPlayers), connectedPlayers(0) {
-    std::cout << "🔧 ClientManager vytvořen (požadováno " << requiredPlayers << " hráčů)" << std::endl;
+ClientManager::ClientManager(int requiredPlayers, NetworkManager* networkManager, TimerWheel* timerWheel,
+                             SessionPool* sessionPool, Strand* strand)
+    : networkManager(networkManager), timerWheel(timerWheel), sessionPool(sessionPool), strand(strand),
+      requiredPlayers(requiredPlayers), connectedPlayers(0) {
+    LOG_INFO("🔧 ClientManager vytvořen (požadováno {} hráčů)", requiredPlayers);
 
     clientNumbers.resize(requiredPlayers, 0);
 }
@@ -17,13 +21,9 @@ ClientManager::~ClientManager() {
 
     for (auto* client : clients) {
         if (client) {
-            if (client->clientThread.joinable()) {
-                client->clientThread.detach();
-            }
-            if (client->socket >= 0) {
-                close(client->socket);
-            }
-            delete client;
+            cancelTimers(client);
+            networkManager->closeSocket(client->socket);
+            sessionPool->release(client);
         }
     }
     clients.clear();
@@ -44,41 +44,48 @@ int ClientManager::getFreeNumber() {
 // ADD & REMOVE CLIENT
 // ============================================================
 ClientInfo* ClientManager::addClient(int socket, const std::string& address) {
-    std::lock_guard<std::mutex> lock(clientsMutex);
+    std::unique_lock<std::mutex> lock(clientsMutex);
 
-    auto* client = new ClientInfo{
-        socket,
-        getFreeNumber(),
-        address,
-        true,
-        std::thread(),
-        std::chrono::steady_clock::now(),
-        false,
-        "",
-        false,
-        std::chrono::steady_clock::now(),
-    };
+    // Slot z poolu – po rozběhu serveru se při připojení nic nealokuje
+    ClientInfo* client = sessionPool->acquire(socket, getFreeNumber(), address);
 
     connectedPlayers++;
+    activeCount++;
     clients.push_back(client);
 
-    std::cout << "✓ Klient #" << client->playerNumber << " přidán (celkem: "
-              << connectedPlayers << "/" << requiredPlayers << ")" << std::endl;
+    // Nový klient se musí včas autorizovat a pak pravidelně ozývat
+    armTimer(client, &ClientInfo::welcomeTimer, std::chrono::seconds(WELCOME_TIMEOUT_SECONDS),
+             &ClientManager::onWelcomeTimeout);
+    armTimer(client, &ClientInfo::idleTimer, std::chrono::seconds(IDLE_TIMEOUT_SECONDS),
+             &ClientManager::onIdleTimeout);
 
+    LOG_INFO("✓ Klient #{} přidán (celkem: {}/{})", client->playerNumber, connectedPlayers.load(), requiredPlayers);
+
+    lock.unlock();
+    notifySeats();
     return client;
 }
 
 void ClientManager::removeClient(ClientInfo* client) {
     if (!client) return;
 
-    std::lock_guard<std::mutex> lock(clientsMutex);
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
 
-    auto it = std::find(clients.begin(), clients.end(), client);
-    if (it != clients.end()) {
+        auto it = std::find(clients.begin(), clients.end(), client);
+        if (it == clients.end()) {
+            return;
+        }
         clients.erase(it);
         connectedPlayers--;
-        std::cout << "✓ Klient #" << client->playerNumber << " odstraněn" << std::endl;
+        if (!client->isDisconnected) {
+            activeCount--;
+        }
+        cancelTimers(client);
+        LOG_INFO("✓ Klient #{} odstraněn", client->playerNumber);
     }
+    notifySeats();
+    sessionPool->release(client);
 }
 
 // ============================================================
@@ -89,48 +96,71 @@ void ClientManager::disconnectAll() {
     {
         std::lock_guard<std::mutex> lock(clientsMutex);
         clientsCopy = clients;
-        std::cout << "🔌 Odpojuji " << clientsCopy.size() << " klientů..." << std::endl;
+        LOG_INFO("🔌 Odpojuji {} klientů...", clientsCopy.size());
     }
 
+    // Všem pošleme DISCONNECT a zavřeme zápis – nikdo nečeká, klienti zprávu dočtou sami
     for (auto* client : clientsCopy) {
         if (client && client->connected) {
-            networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT, {"Server se vypíná"});
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            shutdown(client->socket, SHUT_RDWR);
-            close(client->socket);
+            networkManager->sendMessage(client, Protocol::MessageType::DISCONNECT, {"Server se vypíná"});
+            networkManager->closeSocketAfter(client->socket);
+            client->socket = -1;
             client->connected = false;
         }
     }
 }
 
-void ClientManager::disconnectClient(ClientInfo* client) {
+void ClientManager::kickClient(ClientInfo* client, std::vector<std::string> reason) {
     if (!client) return;
 
-    std::cout << "\n" << std::string(50, '-') << std::endl;
-    std::cout << "🔌 Odpojuji hráče #" << client->playerNumber << std::endl;
-    std::cout << "  - IP: " << client->address << std::endl;
-    std::cout << "  - Socket: " << client->socket << std::endl;
-
-    client->connected = false;
-    clientNumbers[client->playerNumber] = 0;
+    // DISCONNECT odejde z fronty spojení, socket se zavře až po lhůtě v časovém kole
+    networkManager->sendMessage(client, Protocol::MessageType::DISCONNECT, std::move(reason));
+    disconnectClient(client, true);
+}
 
-    if (client->socket >= 0) {
-        shutdown(client->socket, SHUT_RDWR);
-        close(client->socket);
-        client->socket = -1;
-    }
+void ClientManager::disconnectClient(ClientInfo* client, bool graceful) {
+    if (!client) return;
 
     {
         std::lock_guard<std::mutex> lock(clientsMutex);
+
+        // Klienta už odpojil někdo jiný – jeho slot mohl být mezitím recyklován
         auto it = std::find(clients.begin(), clients.end(), client);
-        if (it != clients.end()) {
-            clients.erase(it);
-            connectedPlayers--;
-            std::cout << "  - Odstraněn ze seznamu" << std::endl;
-            std::cout << "  - Zbývá " << connectedPlayers << "/" << requiredPlayers << " hráčů" << std::endl;
+        if (it == clients.end()) {
+            return;
+        }
+
+        cancelTimers(client);
+        clients.erase(it);
+        connectedPlayers--;
+        if (!client->isDisconnected) {
+            activeCount--;
+        }
+        if (client->playerNumber >= 0) {
+            clientNumbers[client->playerNumber] = 0;
+        }
+    }
+
+    LOG_INFO("\n{}", std::string(50, '-'));
+    LOG_INFO("🔌 Odpojuji hráče #{}", client->playerNumber);
+    LOG_INFO("  - IP: {}", client->address);
+    LOG_INFO("  - Socket: {}", client->socket.load());
+
+    client->connected = false;
+
+    if (client->socket >= 0) {
+        if (graceful) {
+            networkManager->closeSocketAfter(client->socket);
+        } else {
+            networkManager->closeSocket(client->socket);
         }
+        client->socket = -1;
     }
 
+    LOG_INFO("  - Odstraněn ze seznamu");
+    LOG_INFO("  - Zbývá {}/{} hráčů", connectedPlayers.load(), requiredPlayers);
+    notifySeats();
+
     // Notifikace ostatních - teď je bezpečná
     std::vector<std::string> statusData;
     statusData.emplace_back("1"); // code
@@ -138,16 +168,16 @@ void ClientManager::disconnectClient(ClientInfo* client) {
     statusData.emplace_back(std::to_string(connectedPlayers));
 
     if (client->approved) {
-        for (auto c : clients) {
-            if (c->playerNumber != client->playerNumber) {
-                sendToPlayer(c->playerNumber, Protocol::MessageType::STATUS, statusData);
-            }
-        }
+        broadcastOthers(client->playerNumber, Protocol::MessageType::STATUS, statusData);
         authorizeCount--;
+        notifyReadiness();
     }
 
-    std::cout << "✅ Hráč #" << client->playerNumber << " odpojen" << std::endl;
-    std::cout << std::string(50, '-') << std::endl;
+    LOG_INFO("✅ Hráč #{} odpojen", client->playerNumber);
+    LOG_INFO("{}", std::string(50, '-'));
+
+    // Slot se vrací do poolu – handly držené jinde od teď relaci nenajdou
+    sessionPool->release(client);
 }
 
 // ============================================================
@@ -180,7 +210,7 @@ ClientInfo* ClientManager::findDisconnectedClient(const std::string& nickname) {
 
     for (auto* client : clients) {
         if (client && client->isDisconnected && client->nickname == nickname) {
-            auto elapsed = std::chrono::steady_clock::now() - client->lastSeen;
+            auto elapsed = std::chrono::steady_clock::now() - client->lastSeen.load();
             auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
 
             if (seconds < RECONNECT_TIMEOUT_SECONDS) {
@@ -191,13 +221,62 @@ ClientInfo* ClientManager::findDisconnectedClient(const std::string& nickname) {
     return nullptr;
 }
 
+bool ClientManager::canResume(ClientInfo* client) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+
+    if (!client || !client->isDisconnected ||
+        std::find(clients.begin(), clients.end(), client) == clients.end()) {
+        return false;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - client->lastSeen.load();
+    return elapsed < std::chrono::seconds(RECONNECT_TIMEOUT_SECONDS);
+}
+
 // ============================================================
 // VÝPADEK & RECONNECTION
 // ============================================================
+void ClientManager::detachClient(ClientInfo* client) {
+    if (!client) return;
+
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+
+        auto it = std::find(clients.begin(), clients.end(), client);
+        if (it == clients.end()) {
+            return;
+        }
+
+        LOG_INFO("🗑️ Odstraňuji dočasného klienta se socketem {} (reconnect do jiné místnosti)", client->socket.load());
+        cancelTimers(client);
+        clients.erase(it);
+        connectedPlayers--;
+        if (!client->isDisconnected) {
+            activeCount--;
+        }
+        if (client->playerNumber >= 0) {
+            clientNumbers[client->playerNumber] = 0;
+        }
+    }
+    notifySeats();
+
+    // Socket si ponechává nová relace, do poolu se vrací jen slot
+    client->socket = -1;
+    sessionPool->release(client);
+}
+
+void ClientManager::holdClient(ClientInfo* client) {
+    if (!client) return;
+
+    // Dokud o spojení rozhoduje původní místnost, časovače ho zavřít nesmí
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    cancelTimers(client);
+}
+
 bool ClientManager::reconnectClient(ClientInfo* oldClient, int newSocket) {
     if (!oldClient) return false;
 
-    std::cout << "🔄 Reconnecting hráče #" << oldClient->playerNumber << std::endl;
+    LOG_INFO("🔄 Reconnecting hráče #{}", oldClient->playerNumber);
 
     {
         std::lock_guard<std::mutex> lock(clientsMutex);
@@ -208,46 +287,70 @@ bool ClientManager::reconnectClient(ClientInfo* oldClient, int newSocket) {
             });
 
         if (it != clients.end()) {
-            std::cout << "🗑️ Odstraňuji dočasného klienta se socketem " << newSocket << std::endl;
-            delete *it;
+            LOG_INFO("🗑️ Odstraňuji dočasného klienta se socketem {}", newSocket);
+            cancelTimers(*it);
+            sessionPool->release(*it);
             clients.erase(it);
             connectedPlayers--;
+            activeCount--;
+        }
+
+        // Nastaví nový socket
+        oldClient->socket = newSocket;
+        oldClient->connected = true;
+        if (oldClient->isDisconnected) {
+            oldClient->isDisconnected = false;
+            activeCount++;
         }
     }
+    notifySeats();
 
-    // Nastaví nový socket
-    oldClient->socket = newSocket;
-    oldClient->connected = true;
-    oldClient->isDisconnected = false;
     oldClient->lastSeen = std::chrono::steady_clock::now();
 
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        timerWheel->cancel(oldClient->reconnectTimer);
+        oldClient->reconnectTimer = 0;
+        armTimer(oldClient, &ClientInfo::idleTimer, std::chrono::seconds(IDLE_TIMEOUT_SECONDS),
+                 &ClientManager::onIdleTimeout);
+    }
+
     // Status broadcast
     std::vector<std::string> statusData;
     statusData.emplace_back("3");
     statusData.emplace_back(oldClient->nickname);
 
-    for (auto c : clients) {
-        if (c->playerNumber != oldClient->playerNumber) {
-            sendToPlayer(c->playerNumber, Protocol::MessageType::STATUS, statusData);
-        }
-    }
+    broadcastOthers(oldClient->playerNumber, Protocol::MessageType::STATUS, statusData);
 
+    notifyReadiness();
     return true;
 }
 
 void ClientManager::handleClientDisconnection(ClientInfo* client) {
     if (!client) return;
 
-    std::cout << "\n🔌 Hráč #" << client->playerNumber << " se odpojil - čekám na reconnect" << std::endl;
+    LOG_INFO("\n🔌 Hráč #{} se odpojil - čekám na reconnect", client->playerNumber);
 
     client->connected = false;
-    client->isDisconnected = true;
     client->lastSeen = std::chrono::steady_clock::now();
 
-    std::cout << "🔌 Uzavírám socket " << client->socket << std::endl;
+    // Místo kontroly nečinnosti teď běží lhůta na reconnect
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (!client->isDisconnected) {
+            client->isDisconnected = true;
+            activeCount--;
+        }
+        timerWheel->cancel(client->idleTimer);
+        client->idleTimer = 0;
+        armTimer(client, &ClientInfo::reconnectTimer, std::chrono::seconds(RECONNECT_TIMEOUT_SECONDS),
+                 &ClientManager::onReconnectTimeout);
+    }
+    notifySeats();
+
     if (client->socket >= 0) {
-        shutdown(client->socket, SHUT_RDWR);
-        close(client->socket);
+        LOG_INFO("🔌 Uzavírám socket {}", client->socket.load());
+        networkManager->closeSocket(client->socket);
         client->socket = -1;
     }
 
@@ -256,82 +359,98 @@ void ClientManager::handleClientDisconnection(ClientInfo* client) {
     statusData.emplace_back(client->nickname);
     statusData.emplace_back(std::to_string(RECONNECT_TIMEOUT_SECONDS));
 
-    for (auto& c : clients) {
-        if (c->playerNumber != client->playerNumber) {
-            sendToPlayer(c->playerNumber, Protocol::MessageType::STATUS, statusData);
-        }
-    }
+    broadcastOthers(client->playerNumber, Protocol::MessageType::STATUS, statusData);
 
-    std::cout << "⏳ Čekám " << RECONNECT_TIMEOUT_SECONDS << "s na reconnect hráče #"
-              << client->playerNumber << std::endl;
-}
-
-void ClientManager::checkDisconnectedClients(bool running) {
-    while (running) {
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-
-        std::vector<ClientInfo*> toRemove;
-        std::vector<ClientInfo*> toDisconnect;
-
-        {
-            std::lock_guard<std::mutex> lock(clientsMutex);
-            auto now = std::chrono::steady_clock::now();
-
-            for (auto* client : clients) {
-                if (!client) continue;
-
-                auto elapsed = now - client->lastSeen;
-                auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
-
-                // Kontrola autorizačního timeoutu JEN pro nové klienty
-                if (client->playerNumber == -1 && !client->approved) {
-                    auto timeSinceCreation = now - client->createdAt;
-                    auto secondsSinceCreation = std::chrono::duration_cast<std::chrono::seconds>(
-                        timeSinceCreation
-                    ).count();
-
-                    // Timeout 10s POUZE pro nové klienty (ne pro reconnect)
-                    if (secondsSinceCreation >= 10) {
-                        std::cout << "⏱️ Klient #" << client->playerNumber
-                                  << " se neautorizoval do 10s – odpojuji" << std::endl;
-                        toDisconnect.push_back(client);
-                        continue;
-                    }
-                }
-
-                // === Klient je disconnected (čekáme na reconnect) ===
-                if (client->isDisconnected) {
-                    if (seconds >= RECONNECT_TIMEOUT_SECONDS) {
-                        std::cout << "⏱️ Timeout pro odpojeného hráče #" << client->playerNumber
-                                  << " (" << seconds << "s) - odstraňuji permanentně" << std::endl;
-                        toRemove.push_back(client);
-                    } else {
-                        std::cout << "⏳ Hráč #" << client->playerNumber
-                                  << " odpojený " << seconds << "s / "
-                                  << RECONNECT_TIMEOUT_SECONDS << "s" << std::endl;
-                    }
-                }
-
-                if (client->connected && now - client->lastSeen > std::chrono::seconds(10)) {
-                    std::cout << "💀 Klient #" << client->playerNumber << " timeout" << std::endl;
-                    toDisconnect.push_back(client);
-                }
-            }
-        }
+    LOG_INFO("⏳ Čekám {}s na reconnect hráče #{}", RECONNECT_TIMEOUT_SECONDS, client->playerNumber);
+}
 
-        // Označíme jako disconnected
-        for (auto* client : toDisconnect) {
-            if (client->playerNumber == -1) {
-                disconnectClient(client);
-            } else {
-                handleClientDisconnection(client);
+void ClientManager::authorizeClient(ClientInfo* client) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    client->approved = true;
+    timerWheel->cancel(client->welcomeTimer);
+    client->welcomeTimer = 0;
+}
+
+// ============================================================
+// ČASOVAČE - welcome, reconnect a nečinnost (časové kolo)
+// ============================================================
+void ClientManager::armTimer(ClientInfo* client, TimerWheel::TimerId ClientInfo::*timer,
+                             std::chrono::milliseconds delay, void (ClientManager::*handler)(ClientInfo*)) {
+    timerWheel->cancel(client->*timer);
+    SessionHandle session(client);
+    // Vlákno časového kola úlohu jen předá strandu – odpojení a broadcasty
+    // běží tam, kde se klient obsluhuje
+    client->*timer = timerWheel->schedule(delay, [this, session, timer, handler,
+                                                  token = timers.track()](TimerWheel::TimerId id) {
+        strand->post([this, session, timer, handler, id] {
+            if (claimTimer(session, timer, id)) {
+                ClientInfo* client = session.client;
+                auto batch = networkManager->batch();
+                (this->*handler)(client);
             }
-        }
+        });
+    });
+}
 
-        // Permanentně odebereme
-        for (auto* client : toRemove) {
-            disconnectClient(client);
-        }
+void ClientManager::cancelTimers(ClientInfo* client) {
+    for (auto timer : {&ClientInfo::welcomeTimer, &ClientInfo::reconnectTimer, &ClientInfo::idleTimer}) {
+        timerWheel->cancel(client->*timer);
+        client->*timer = 0;
+    }
+}
+
+bool ClientManager::claimTimer(const SessionHandle& session, TimerWheel::TimerId ClientInfo::*timer, TimerWheel::TimerId id) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+
+    // Klient mohl být mezitím odstraněn (slot recyklován) nebo časovač přeplánován
+    ClientInfo* client = session.get();
+    if (!client || std::find(clients.begin(), clients.end(), client) == clients.end() || client->*timer != id) {
+        return false;
+    }
+
+    client->*timer = 0;
+    return true;
+}
+
+void ClientManager::onWelcomeTimeout(ClientInfo* client) {
+    if (client->approved) {
+        return;
+    }
+
+    LOG_INFO("⏱️ Klient #{} se neautorizoval do {}s – odpojuji", client->playerNumber, WELCOME_TIMEOUT_SECONDS);
+    disconnectClient(client);
+}
+
+void ClientManager::onReconnectTimeout(ClientInfo* client) {
+    if (!client->isDisconnected) {
+        return;
+    }
+
+    LOG_INFO("⏱️ Timeout pro odpojeného hráče #{} ({}s) - odstraňuji permanentně", client->playerNumber, RECONNECT_TIMEOUT_SECONDS);
+    disconnectClient(client);
+}
+
+void ClientManager::onIdleTimeout(ClientInfo* client) {
+    if (!client->connected) {
+        return;
+    }
+
+    // Klient se mezitím ozval – kontrolu posuneme na konec nové lhůty
+    auto idle = std::chrono::steady_clock::now() - client->lastSeen.load();
+    if (idle < std::chrono::seconds(IDLE_TIMEOUT_SECONDS)) {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+            std::chrono::seconds(IDLE_TIMEOUT_SECONDS) - idle);
+
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        armTimer(client, &ClientInfo::idleTimer, remaining, &ClientManager::onIdleTimeout);
+        return;
+    }
+
+    LOG_INFO("💀 Klient #{} timeout", client->playerNumber);
+    if (client->playerNumber == -1) {
+        disconnectClient(client);
+    } else {
+        handleClientDisconnection(client);
     }
 }
 
@@ -343,15 +462,8 @@ int ClientManager::getConnectedCount() const {
 }
 
 int ClientManager::getActiveCount() const {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(clientsMutex));
-
-    int count = 0;
-    for (auto* c : clients) {
-        if (c && !c->isDisconnected) {
-            count++;
-        }
-    }
-    return count;
+    // Udržováno při každé změně – bez zámku a procházení klientů
+    return activeCount;
 }
 
 std::vector<ClientInfo*> ClientManager::getClients() {
@@ -363,134 +475,122 @@ std::vector<ClientInfo*> ClientManager::getClients() {
 // Funkce k poslání zpráv
 // ============================================================
 void ClientManager::broadcastMessage(Protocol::MessageType msgType, std::vector<std::string> msg) {
+    // Odesílání jen zařazuje do front spojení, takže ho lze provést pod zámkem
+    // (klient tak nemůže být mezitím odstraněn)
     std::lock_guard<std::mutex> lock(clientsMutex);
-    std::cout << "📢 Broadcast: " <<  static_cast<int>(msgType)  << std::endl;
+
+    LOG_DEBUG("📢 Broadcast: {}", static_cast<int>(msgType));
+
+    // Data se serializují jednou, každý klient dostane jen vlastní hlavičku
+    Protocol::Payload payload = Protocol::serializePayload(msg);
 
     for (auto* client : clients) {
         if (client && client->connected) {
-            networkManager->sendMessage(client->socket, client->playerNumber, msgType, msg);
+            networkManager->sendPayload(client, msgType, payload);
         }
     }
 }
 
-void ClientManager::sendToPlayer(int playerNumber, Protocol::MessageType msgType, std::vector<std::string> msg) {
+void ClientManager::broadcastOthers(int playerNumber, Protocol::MessageType msgType, std::vector<std::string> msg) {
     std::lock_guard<std::mutex> lock(clientsMutex);
 
+    Protocol::Payload payload = Protocol::serializePayload(msg);
+
     for (auto* client : clients) {
-        if (client && client->playerNumber == playerNumber && client->connected) {
-            networkManager->sendMessage(client->socket, client->playerNumber, msgType, msg);
-            return;
+        if (client && client->playerNumber != playerNumber && client->connected) {
+            networkManager->sendPayload(client, msgType, payload);
         }
     }
-
-    std::cerr << "⚠ Hráč #" << playerNumber << " nebyl nalezen" << std::endl;
 }
 
-// ============================================================
-// Algoritmus pro vrácení paketů
-// ============================================================
-u_int8_t ClientManager::findPacketID(int clientNumber, int packetID) {
-    std::vector<std::string> packets = networkManager->getPackets();  // Reference pro efektivitu
-
-    if (packetID == -1) {
-        for (int i = packets.size() - 1; i >= 0; i--) {
-            const auto& packet = packets[i];
-            Protocol::Message msg = Protocol::deserialize(packet);
-            int packetClient = msg.clientID;
-            if (packetClient == clientNumber) {
-                return msg.packetID;;
-            }
-        }
-    } else {
-        for (int i = packets.size() - 1; i >= 0; i--) {
-            const auto& packet = packets[i];
-            Protocol::Message msg = Protocol::deserialize(packet);
-            int packetClient = msg.clientID;
-            int actualPacketID = msg.packetID;
-            if (packetClient == clientNumber && packetID == actualPacketID) {
-                return msg.packetID;
-            }
+void ClientManager::sendToPlayer(int playerNumber, Protocol::MessageType msgType, std::vector<std::string> msg) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+
+    for (auto* client : clients) {
+        if (client && client->playerNumber == playerNumber && client->connected) {
+            networkManager->sendMessage(client, msgType, msg);
+            return;
         }
     }
 
-    return {};
+    LOG_WARN("⚠ Hráč #{} nebyl nalezen", playerNumber);
 }
 
-void ClientManager::sendLossPackets(ClientInfo* client, int lastReceivedPacketID) {
-    std::cout << "\n🔄 Zjišťuji ztracené packety pro klienta #" << client->playerNumber << std::endl;
-    std::cout << "   Poslední přijatý packet: " << lastReceivedPacketID << std::endl;
-
-    // Najdeme nejnovější packet ID pro tohoto klienta
-    int latestPacketID = networkManager->findLatestPacketID(client->playerNumber);
-
-    if (latestPacketID == -1) {
-        std::cout << "   ℹ️ Žádné packety k odeslání" << std::endl;
-        return;
-    }
+void ClientManager::sendToPlayers(const std::vector<int>& playerNumbers, Protocol::MessageType msgType,
+                                  const Protocol::Payload& payload) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
 
-    std::cout << "   Nejnovější packet: " << latestPacketID << std::endl;
+    for (int playerNumber : playerNumbers) {
+        auto it = std::find_if(clients.begin(), clients.end(), [playerNumber](ClientInfo* client) {
+            return client && client->playerNumber == playerNumber && client->connected;
+        });
 
-    // Pokud je klient aktuální, nic neposíláme
-    if (lastReceivedPacketID >= latestPacketID) {
-        std::cout << "   ✅ Klient je aktuální" << std::endl;
-        return;
+        if (it == clients.end()) {
+            LOG_WARN("⚠ Hráč #{} nebyl nalezen", playerNumber);
+            continue;
+        }
+        networkManager->sendPayload(*it, msgType, payload);
     }
+}
 
-    // Sebereme všechny chybějící packety
-    std::vector<std::string> missingPackets;
+void ClientManager::sendStateToPlayers(const std::vector<int>& playerNumbers, const StateUpdate& update) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
 
-    // Procházíme od (lastReceived + 1) do latest (včetně)
-    for (int id = lastReceivedPacketID + 1; id <= latestPacketID; id++) {
-        // Ošetření wraparound (pokud ID překročilo 255)
-        int actualID = id % NetworkManager::MAXIMUM_PACKET_SIZE;
+    for (int playerNumber : playerNumbers) {
+        auto it = std::find_if(clients.begin(), clients.end(), [playerNumber](ClientInfo* client) {
+            return client && client->playerNumber == playerNumber && client->connected;
+        });
 
-        std::string packet = networkManager->findPacketByID(client->playerNumber, actualID);
-        Protocol::Message msg = Protocol::deserialize(packet);
+        if (it == clients.end()) {
+            LOG_WARN("⚠ Hráč #{} nebyl nalezen", playerNumber);
+            continue;
+        }
 
-        if (!packet.empty()) {
-            missingPackets.push_back(packet);
-            std::cout << "   📦 Našel packet ID:" << actualID << " (type: " << static_cast<int>(msg.type) << ")" << std::endl;
-        } else {
-            std::cerr << "   ⚠️ Packet ID:" << actualID << " nenalezen nebo přepsán" << std::endl;
+        ClientInfo* client = *it;
+        if (!client->deltaState) {
+            networkManager->sendPayload(client, Protocol::MessageType::STATE, update.full);
+            continue;
         }
+
+        // Rozdíl stačí, jen pokud klient má přesně předchozí verzi – jinak plný snímek
+        bool hasBase = update.delta && client->stateVersion + 1 == update.version;
+        networkManager->sendPayload(client, Protocol::MessageType::STATE_DELTA,
+                                    hasBase ? update.delta : update.snapshot);
+        client->stateVersion = update.version;
     }
+}
 
-    if (latestPacketID < lastReceivedPacketID) {
-        std::cout << "   🔄 Detekován wraparound" << std::endl;
+// ============================================================
+// Algoritmus pro vrácení paketů
+// ============================================================
+void ClientManager::sendLossPackets(ClientInfo* client, uint32_t lastReceivedPacketID) {
+    LOG_INFO("\n🔄 Zjišťuji ztracené packety pro klienta #{}", client->playerNumber);
+    LOG_INFO("   Poslední přijatý packet: {}", lastReceivedPacketID);
 
-        // Nejdřív od (lastReceived + 1) do 254
-        for (int id = lastReceivedPacketID + 1; id < NetworkManager::MAXIMUM_PACKET_SIZE; id++) {
-            std::string packet = networkManager->findPacketByID(client->playerNumber, id);
-            if (!packet.empty()) {
-                missingPackets.push_back(packet);
-                std::cout << "   📦 Našel packet ID:" << id << " (wraparound)" << std::endl;
-            }
-        }
+    // Nejnovější packet ID z řady tohoto klienta
+    uint32_t latestPacketID = client->history.latestID();
 
-        // Pak od 0 do latest
-        for (int id = 0; id <= latestPacketID; id++) {
-            std::string packet = networkManager->findPacketByID(client->playerNumber, id);
-            if (!packet.empty()) {
-                missingPackets.push_back(packet);
-                std::cout << "   📦 Našel packet ID:" << id << " (wraparound)" << std::endl;
-            }
-        }
+    if (latestPacketID == 0) {
+        LOG_INFO("   ℹ️ Žádné packety k odeslání");
+        return;
     }
 
-    std::cout << "   📊 Celkem nalezeno " << missingPackets.size() << " chybějících paketů" << std::endl;
-
-    // Posíláme packety ve správném pořadí (od nejstaršího po nejnovější)
-    for (const auto& packet : missingPackets) {
-        Protocol::Message msg = Protocol::deserialize(packet);
+    LOG_INFO("   Nejnovější packet: {}", latestPacketID);
 
-        std::cout << "   📤 Posílám packet ID:" << msg.packetID
-                  << " (type: " << static_cast<int>(msg.type) << ")" << std::endl;
+    // Pokud je klient aktuální, nic neposíláme
+    if (lastReceivedPacketID == latestPacketID) {
+        LOG_INFO("   ✅ Klient je aktuální");
+        return;
+    }
 
-        networkManager->sendMessage(client->socket, client->playerNumber, msg.type, msg.fields);
+    // Packety odchází ve správném pořadí (od nejstaršího po nejnovější) s původními ID
+    bool truncated = false;
+    size_t count = networkManager->retransmit(client, lastReceivedPacketID, truncated);
 
-        // Malá pauza mezi packety pro zabránění zahlcení
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (truncated) {
+        LOG_WARN("   ⚠️ Část paketů už byla z historie přepsána (uchovává se {})", PacketHistory::CAPACITY);
     }
 
-    std::cout << "   ✅ Znovuposlání dokončeno\n" << std::endl;
+    LOG_INFO("   📊 Znovu odesláno {} paketů", count);
+    LOG_INFO("   ✅ Znovuposlání dokončeno\n");
 }
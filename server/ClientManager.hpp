@@ -1,6 +1,8 @@
 #ifndef CLIENT_MANAGER_HPP
 #define CLIENT_MANAGER_HPP
 
+#include <atomic>
+#include <functional>
 #include <vector>
 #include <mutex>
 #include <string>
@@ -8,25 +10,68 @@
 #include <chrono>
 
 #include "Protocol.hpp"
+#include "PacketHistory.hpp"
+#include "TimerWheel.hpp"
 
+// Relace klienta. Relace žijí ve slotech SessionPoolu a po odpojení se
+// recyklují – kdo si ukazatel drží déle (spojení reaktoru, úlohy strandu,
+// časovače), porovná si generaci. Pole jsou seřazena podle četnosti přístupu:
+// stav a časy v první cache line, texty a historie paketů až za nimi.
+// Socket, stav připojení a poslední aktivitu čtou I/O vlákna i strand místnosti,
+// proto jsou atomické; ostatní pole patří strandu místnosti (nebo clientsMutex).
 struct ClientInfo {
-    int socket;                 // Socket klienta
-    int playerNumber;           // Číslo hráče přidělené serverem
+    // ===== Horká pole (každá zpráva a časovač) =====
+    std::atomic<uint32_t> generation{0}; // Generace slotu (mění se při každém uvolnění relace)
+    std::atomic<int> socket{-1};             // Socket klienta
+    int playerNumber = -1;      // Číslo hráče přidělené serverem
+    std::atomic<bool> connected{false};      // Stav připojení klienta
+    std::atomic<bool> isDisconnected{false}; // Příznak, zda byl klient odpojen (mění se pod clientsMutex)
+    bool approved = false;      // Schválení připojení (např. po reconnectu)
+    bool deltaState = false;    // Klient přijímá STATE_DELTA místo plného STATE
+    uint32_t stateVersion = 0;  // Verze stavu hry, kterou klient má (chráněno clientsMutex)
+    std::atomic<std::chrono::steady_clock::time_point> lastSeen{}; // Čas poslední aktivity klienta
+    std::chrono::steady_clock::time_point createdAt; // Vytvoření proměnné pro timeout při připojení
+    TimerWheel::TimerId welcomeTimer = 0;   // Timeout autorizace (chráněno clientsMutex)
+    TimerWheel::TimerId reconnectTimer = 0; // Lhůta na reconnect po výpadku
+    TimerWheel::TimerId idleTimer = 0;      // Kontrola nečinnosti
+
+    // ===== Studená pole =====
     std::string address;        // IP adresa klienta
-    bool connected;             // Stav připojení klienta
-    std::thread clientThread;   // Vlákno obsluhující klienta
-    std::chrono::steady_clock::time_point lastSeen; // Čas poslední aktivity klienta
-    bool isDisconnected;        // Příznak, zda byl klient odpojen
     std::string nickname;       // Přezdívka hráče
-    bool approved;              // Schválení připojení (např. po reconnectu)
-    std::chrono::steady_clock::time_point createdAt; // Vytvoření proměnné pro timeout při připojení
+    std::string sessionToken;   // Token pro reconnect (prázdný = relace nebyla autorizována)
+    PacketHistory history;      // Vlastní řada ID a historie odeslaných paketů (pro reconnect)
+};
+
+// Ukazatel na relaci spolu s generací, pro kterou platí.
+// Slot po uvolnění zůstává v paměti, takže ověření je vždy bezpečné.
+struct SessionHandle {
+    ClientInfo* client = nullptr;
+    uint32_t generation = 0;
+
+    SessionHandle() = default;
+    explicit SessionHandle(ClientInfo* client)
+        : client(client), generation(client ? client->generation.load() : 0) {}
+
+    ClientInfo* get() const { return client && client->generation == generation ? client : nullptr; }
+};
+
+// Jedna změna stavu hry připravená pro všechny druhy příjemců.
+// Každá varianta se serializuje jednou bez ohledu na počet hráčů.
+struct StateUpdate {
+    uint32_t version = 0;        // Verze stavu po změně
+    Protocol::Payload full;      // Plný STATE pro klienty bez delta režimu
+    Protocol::Payload delta;     // STATE_DELTA vůči verzi version - 1 (nullptr = nepoužít)
+    Protocol::Payload snapshot;  // STATE_DELTA s plným snímkem (klient nemá předchozí verzi)
 };
 
 class NetworkManager;
+class SessionPool;
+class Strand;
 
 class ClientManager {
 public:
-    ClientManager(int requiredPlayers, NetworkManager* networkManager);
+    ClientManager(int requiredPlayers, NetworkManager* networkManager, TimerWheel* timerWheel,
+                  SessionPool* sessionPool, Strand* strand);
     ~ClientManager();
 
 
@@ -36,44 +81,82 @@ public:
     ClientInfo* findClientBySocket(int socket); // Najde clienta podle socketu
     ClientInfo* findClientByPlayerNumber(int playerNumber); // Nalezne klienta podle identifikačního čísla
     void disconnectAll(); // Odpojí všechny klienty
-    void disconnectClient(ClientInfo* client); // Odpojí konkrétního klienta
+    void disconnectClient(ClientInfo* client, bool graceful = false); // Odpojí konkrétního klienta (graceful = socket zavře až po lhůtě)
+    void kickClient(ClientInfo* client, std::vector<std::string> reason); // Pošle DISCONNECT a klienta odpojí bez čekání
 
     // Reconnect
-    ClientInfo* findDisconnectedClient(const std::string& nickname); // Nalezne klienta, kterému spadl socket
+    ClientInfo* findDisconnectedClient(const std::string& nickname); // Nalezne klienta, kterému spadl socket (starší klienti bez tokenu)
+    bool canResume(ClientInfo* client); // Klient čeká na reconnect a lhůta ještě nevypršela
+    void detachClient(ClientInfo* client); // Odebere dočasného klienta bez zavření socketu (reconnect do jiné místnosti)
+    void holdClient(ClientInfo* client); // Zruší časovače dočasného klienta, jehož spojení přebírá jiná místnost
     bool reconnectClient(ClientInfo* oldClient, int newSocket); // Provede recoonect, neboli obnovení klienta zpšt do hry
     void handleClientDisconnection(ClientInfo* client); // Řeší odpojení klienta v případě selhání socketu
-    void checkDisconnectedClients(bool running); // Zjistí, jestli se čeká na recconect nějakého klienta
+    void authorizeClient(ClientInfo* client); // Označí klienta jako autorizovaného a zruší jeho welcome timeout
 
     // Packets
-    void sendLossPackets(ClientInfo* client, int packetID); // Pošle klientovi zmenškané packety
-    u_int8_t findPacketID(int clientNumber, int position); // Nalzenze packety podle ID packetů
+    void sendLossPackets(ClientInfo* client, uint32_t packetID); // Pošle klientovi zmenškané packety
 
     // Gettery
     int getConnectedCount() const; // Vrátí počet připojených hráčů (hráč může být v recconectu)
     int getActiveCount() const; // Vrátí počet všech aktivních hráčů (plně funkční sockety)
     std::vector<ClientInfo*> getClients();
+    bool hasPendingTimers() const { return !timers.idle(); } // Časové kolo ještě drží callback místnosti
 
     // Zprávy
     void broadcastMessage(Protocol::MessageType msgType, std::vector<std::string> msg); // Pošle zprávu všem klientům
+    void broadcastOthers(int playerNumber, Protocol::MessageType msgType, std::vector<std::string> msg); // Pošle zprávu všem klientům kromě hráče
     void sendToPlayer(int playerNumber, Protocol::MessageType msgType, std::vector<std::string> msg);  // Pošle zprávu konkrétnímu klientovi
+    void sendToPlayers(const std::vector<int>& playerNumbers, Protocol::MessageType msgType,
+                       const Protocol::Payload& payload); // Pošle stejná (jednou serializovaná) data více hráčům
+    void sendStateToPlayers(const std::vector<int>& playerNumbers, const StateUpdate& update); // Pošle stav hry podle verze, kterou hráč má
 
     // Synchronizace jména
     int getauthorizeCount() const { return authorizeCount; };
     void setauthorizeCount() { authorizeCount++; };
-    void nullauthorizeCount() { authorizeCount = 0; };
+    void nullauthorizeCount() { authorizeCount = 0; notifyReadiness(); };
+
+    // Připravenost ke hře – posluchač (místnost) se volá při každé změně
+    // počtu autorizovaných nebo aktivních hráčů (mimo zámky ClientManageru)
+    void setReadinessListener(std::function<void()> listener) { readinessListener = std::move(listener); }
+    void notifyReadiness() { if (readinessListener) readinessListener(); }
+
+    // Obsazenost míst – posluchač (index volných míst LobbyManageru) se volá
+    // po každé změně počtu aktivních hráčů (mimo zámky ClientManageru)
+    void setSeatListener(std::function<void()> listener) { seatListener = std::move(listener); }
 
 private:
     NetworkManager* networkManager;
+    TimerWheel* timerWheel;
+    SessionPool* sessionPool;           // Sloty relací (sdílené všemi místnostmi)
+    Strand* strand;                     // Strand místnosti – vypršené časovače zpracuje on
+    TimerWheel::Tracker timers;         // Časovače klientů, které kolo ještě drží
     static constexpr int RECONNECT_TIMEOUT_SECONDS = 60; // Doba na znovupřipojení
     static constexpr int WELCOME_TIMEOUT_SECONDS = 10; // Maximální doba na připojení klienta (neautorizovaného)
+    static constexpr int IDLE_TIMEOUT_SECONDS = 10; // Maximální doba bez zprávy od připojeného klienta
     std::vector<ClientInfo*> clients;   // Pole připojených klientů
     std::mutex clientsMutex;            // Zámek pro přístup ke správě klientů
     int requiredPlayers;                // Pož. počet hráčů
-    int connectedPlayers;               // Počet připojených hráčů
+    std::atomic<int> connectedPlayers;  // Počet připojených hráčů
     std::vector<int> clientNumbers;     // Pole čísel pro inicializaci hráčů
-    int authorizeCount = 0;             // Počet autorizovaných hráčů, připravených ke hře
+    std::atomic<int> authorizeCount{0}; // Počet autorizovaných hráčů, připravených ke hře
+    std::function<void()> readinessListener; // Reakce místnosti na změnu připravenosti
+    std::atomic<int> activeCount{0};    // Počet aktivních hráčů (bez čekajících na reconnect)
+    std::function<void()> seatListener; // Aktualizace indexu volných míst
+
+    void notifySeats() { if (seatListener) seatListener(); }
 
     int getFreeNumber(); // Zjistí dostupné číslo pro inicializaci klienta do hry
+
+    // Časovače klienta (volat pod clientsMutex)
+    void armTimer(ClientInfo* client, TimerWheel::TimerId ClientInfo::*timer, std::chrono::milliseconds delay,
+                  void (ClientManager::*handler)(ClientInfo*)); // Naplánuje časovač klienta
+    void cancelTimers(ClientInfo* client); // Zruší všechny časovače klienta
+    bool claimTimer(const SessionHandle& session, TimerWheel::TimerId ClientInfo::*timer, TimerWheel::TimerId id); // Ověří, že časovač stále patří živé relaci
+
+    // Akce při vypršení časovačů
+    void onWelcomeTimeout(ClientInfo* client);
+    void onReconnectTimeout(ClientInfo* client);
+    void onIdleTimeout(ClientInfo* client);
 };
 
 #endif // CLIENT_MANAGER_HPP
\ No newline at end of file
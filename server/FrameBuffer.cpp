@@ -0,0 +1,77 @@
+#include "FrameBuffer.hpp"
+#include "Protocol.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sys/socket.h>
+
+void FrameBuffer::reserveForRead() {
+    if (data.empty()) {
+        data.resize(INITIAL_CAPACITY);
+    }
+
+    // Vše zpracováno – začneme od začátku bez kopírování
+    if (head == tail) {
+        head = tail = scanned = 0;
+    }
+
+    if (data.size() - tail >= MIN_READ) {
+        return;
+    }
+
+    // Posuneme neúplný rámec na začátek bufferu
+    if (head > 0) {
+        std::memmove(data.data(), data.data() + head, tail - head);
+        scanned -= head;
+        tail -= head;
+        head = 0;
+    }
+
+    // Pořád málo místa – buffer zvětšíme (nejvýš na velikost jedné zprávy)
+    if (data.size() - tail < MIN_READ) {
+        data.resize(std::max(data.size() * 2, tail + MIN_READ));
+    }
+}
+
+ssize_t FrameBuffer::fill(int socket) {
+    reserveForRead();
+
+    size_t space = data.size() - tail;
+    ssize_t r = recv(socket, data.data() + tail, space, MSG_DONTWAIT);
+
+    if (r > 0) {
+        tail += static_cast<size_t>(r);
+        drained = static_cast<size_t>(r) < space;
+    }
+
+    return r;
+}
+
+bool FrameBuffer::nextFrame(std::string_view& frame) {
+    size_t from = std::max(head, scanned);
+    if (from >= tail) {
+        return false;
+    }
+
+    const void* found = std::memchr(data.data() + from, Protocol::TERMINATOR, tail - from);
+    if (!found) {
+        scanned = tail;
+        return false;
+    }
+
+    size_t end = static_cast<const char*>(found) - data.data() + 1;
+    frame = std::string_view(data.data() + head, end - head);
+    head = end;
+    scanned = end;
+    return true;
+}
+
+bool FrameBuffer::takeDrained() {
+    bool wasDrained = drained;
+    drained = false;
+    return wasDrained;
+}
+
+bool FrameBuffer::isOverflowed() const {
+    return tail - head > Protocol::MAX_MESSAGE_SIZE;
+}
@@ -0,0 +1,35 @@
+#ifndef FRAME_BUFFER_HPP
+#define FRAME_BUFFER_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
+// Přijímací buffer jednoho spojení.
+// Čte ze socketu po velkých blocích (jeden recv na událost) a vydává celé
+// rámce zakončené '\n'. Neúplný rámec zůstává v bufferu do dalšího čtení.
+class FrameBuffer {
+public:
+    FrameBuffer() = default;
+
+    ssize_t fill(int socket); // Jedno neblokující čtení ze socketu do volného místa
+    bool nextFrame(std::string_view& frame); // Vydá další celý rámec (platný do dalšího fill)
+    bool takeDrained(); // Vrátí a vynuluje příznak, že poslední čtení vyprázdnilo socket
+    bool isOverflowed() const; // Neúplný rámec překročil maximální velikost zprávy
+    size_t buffered() const { return tail - head; } // Počet nezpracovaných bajtů
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = 4096; // Výchozí velikost bufferu
+    static constexpr size_t MIN_READ = 1024;         // Minimální volné místo pro jedno čtení
+
+    std::vector<char> data;  // Úložiště bajtů
+    size_t head = 0;         // Začátek nezpracovaných dat
+    size_t tail = 0;         // Konec přijatých dat
+    size_t scanned = 0;      // Pozice, do které už byl hledán terminátor
+    bool drained = false;    // Poslední recv vrátil méně, než se vešlo – socket je prázdný
+
+    void reserveForRead(); // Zajistí volné místo na konci bufferu
+};
+
+#endif // FRAME_BUFFER_HPP
@@ -2,82 +2,105 @@
 #include "MessageHandler.hpp"
 #include "NetworkManager.hpp"
 #include "Protocol.hpp"
-#include <iostream>
+#include "Logger.hpp"
 
-GameManager::GameManager(int requiredPlayers, NetworkManager* networkManager, ClientManager* clientManager)
-    : networkManager(networkManager), clientManager(clientManager), requiredPlayers(requiredPlayers) {
+GameManager::GameManager(int requiredPlayers, NetworkManager* networkManager, ClientManager* clientManager,
+                         TimerWheel* timerWheel, Strand* strand)
+    : networkManager(networkManager), clientManager(clientManager), requiredPlayers(requiredPlayers),
+      timerWheel(timerWheel), strand(strand) {
 
-    std::cout << "🔧 GameManager vytvořen (požadováno " << requiredPlayers << " hráčů)" << std::endl;
+    LOG_INFO("🔧 GameManager vytvořen (požadováno {} hráčů)", requiredPlayers);
 }
 
 GameManager::~GameManager() {
+    cancelEvents();
     game = nullptr;
 }
 
+void GameManager::hibernate() {
+    cancelEvents();
+    game = nullptr;
+    lastState = {};
+    trickResponses = 0;
+}
+
+int GameManager::getStateCode() const {
+    return game ? static_cast<int>(game->getState()) : -1;
+}
+
+int GameManager::getActivePlayer() const {
+    if (!game || !game->getActivePlayer()) {
+        return -1;
+    }
+    return game->getActivePlayer()->getNumber();
+}
+
 void GameManager::initPlayers() {
-    std::lock_guard<std::mutex> lock(gameMutex);
     for (auto client : clientManager->getClients()) {
         game->initPlayer(client->playerNumber, client->nickname);
     }
 }
 
 void GameManager::startGame() {
-    std::cout << "\n" << std::string(50, '=') << std::endl;
-    std::cout << "🎮 SPOUŠTÍM HERNÍ LOGIKU 🎮" << std::endl;
-    std::cout << std::string(50, '=') << std::endl;
+    LOG_INFO("\n{}", std::string(50, '='));
+    LOG_INFO("🎮 SPOUŠTÍM HERNÍ LOGIKU 🎮");
+    LOG_INFO("{}", std::string(50, '='));
 
+    // Události předchozí hry (např. nedoručené YOUR_TURN) už neplatí
+    cancelEvents();
     game = std::make_unique<Game>(requiredPlayers);
 
     // ===== KROK 0: Inicializovat hráče =====
     initPlayers();
 
     // ===== KROK 1: Posílám 1. GAME_START =====
-    std::cout << "\n📢 Hra se načítá..." << std::endl;
+    LOG_INFO("\n📢 Hra se načítá...");
 
+    std::vector<int> playerNumbers;
     for (int playerNum = 0; playerNum < requiredPlayers; playerNum++) {
-        clientManager->sendToPlayer(playerNum, Protocol::MessageType::GAME_START, {});
-        std::cout << "✓ Hráč dostal záznam o začátku hry " << playerNum << std::endl;
+        playerNumbers.push_back(playerNum);
     }
 
+    clientManager->sendToPlayers(playerNumbers, Protocol::MessageType::GAME_START, Protocol::serializePayload({}));
+    LOG_INFO("✓ Hráči dostali záznam o začátku hry");
+
     // ===== KROK 2: Prodleva mezi zahájení hry =====
-    std::cout << "\n⏳ Čekám " << WAITING_TIME << " sekund před rozdáním karet..." << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(WAITING_TIME));
-    std::cout << "✓ Čekání dokončeno" << std::endl;
+    // Vlákno nečeká – rozdání karet proběhne jako odložená událost
+    LOG_INFO("\n⏳ Rozdám karty za {} sekund...", WAITING_TIME.count());
+    scheduleEvent(WAITING_TIME, [this] { dealAndStart(); });
+}
+
+void GameManager::dealAndStart() {
+    LOG_INFO("✓ Čekání dokončeno");
 
     // ===== KROK 3 Inicializace hry a rozdání karet =====
-    {
-        std::cout << "\n🃏 Rozdávám karty hráčům..." << std::endl;
-        std::lock_guard<std::mutex> lock(gameMutex);
-        game->defineLicitator(0);
-        game->dealCards();
-        std::cout << "✓ Karty rozdány" << std::endl;
-    }
+    LOG_INFO("\n🃏 Rozdávám karty hráčům...");
+    game->defineLicitator(0);
+    game->dealCards();
+    LOG_INFO("✓ Karty rozdány");
 
     // ===== KROK 4: Odeslat GAME_START s daty =====
-    std::cout << "\n📢 Posílám GAME_START všem hráčům..." << std::endl;
+    LOG_INFO("\n📢 Posílám GAME_START všem hráčům...");
 
     for (int playerNum = 0; playerNum < requiredPlayers; playerNum++) {
         std::vector<std::string> gameData = serializeGameStart(playerNum);
         clientManager->sendToPlayer(playerNum, Protocol::MessageType::GAME_START, gameData);
-        std::cout << "✓ GAME_START odesláno hráči " << playerNum << std::endl;
+        LOG_INFO("✓ GAME_START odesláno hráči {}", playerNum);
     }
 
-    std::cout << "\n" << std::string(50, '=') << std::endl;
-    std::cout << "✅ Hra úspěšně spuštěna!" << std::endl;
-    std::cout << std::string(50, '=') << std::endl;
+    LOG_INFO("\n{}", std::string(50, '='));
+    LOG_INFO("✅ Hra úspěšně spuštěna!");
+    LOG_INFO("{}", std::string(50, '='));
 
     // ===== KROK 5: Odeslat GAME_STATE =====
-    std::cout << "\n📢 Posílám GAME_STATE všem hráčům..." << std::endl;
+    LOG_INFO("\n📢 Posílám GAME_STATE všem hráčům...");
 
+    std::vector<int> playerNumbers;
     for (int playerNum = 0; playerNum < requiredPlayers; playerNum++) {
-        sendGameStateToPlayer(playerNum);
-        std::cout << "✓ GAME_START odesláno hráči " << playerNum << std::endl;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(gameMutex);
-        game->stateChanged = 0;
+        playerNumbers.push_back(playerNum);
     }
+    broadcastGameState(playerNumbers);
+    game->stateChanged = 0;
 }
 
 // ============================================================
@@ -103,7 +126,7 @@ std::vector<std::string> GameManager::serializeGameState() {
             gameState.emplace_back("1"); // isPlayedCards
             std::string cardsArray;
             for (auto map : game->getPlayedCards()) {
-                std::cout << "PlayedCard  - " << map.second.toString() << std::endl;
+                LOG_DEBUG("PlayedCard  - {}", map.second.toString());
                 cardsArray += map.second.toString();
                 cardsArray += ":";
             }
@@ -118,6 +141,22 @@ std::vector<std::string> GameManager::serializeGameState() {
     return gameState;
 }
 
+std::vector<std::string> GameManager::serializeStateDelta(uint32_t version, uint32_t baseVersion,
+                                                          const StateFields& from, const StateFields& to) {
+    // version|baseVersion|index=hodnota|... (baseVersion 0 = snímek od prázdného stavu)
+    std::vector<std::string> delta;
+    delta.emplace_back(std::to_string(version));
+    delta.emplace_back(std::to_string(baseVersion));
+
+    for (size_t i = 0; i < STATE_FIELDS; i++) {
+        if (from[i] != to[i]) {
+            delta.emplace_back(std::to_string(i) + "=" + to[i]);
+        }
+    }
+
+    return delta;
+}
+
 std::vector<std::string> GameManager::serializeGameStart(int playerNumber) {
     // <PLAYER>|<players>|<licitator>|<activePlayer>
     std::vector<std::string> gameData;
@@ -167,38 +206,58 @@ std::vector<std::string> GameManager::serializeInvalid(int playerNumber) {
 // ============================================================
 
 void GameManager::sendInvalidPlayer(int playerNumber) {
-    std::cout << "📤 Posílám neplatný tah hráči #" << playerNumber << std::endl;
-
-    std::lock_guard<std::mutex> lock(gameMutex);
+    LOG_DEBUG("📤 Posílám neplatný tah hráči #{}", playerNumber);
 
     std::vector<std::string> msg = serializeInvalid(playerNumber);
     clientManager->sendToPlayer(playerNumber, Protocol::MessageType::INVALID, msg);
 
-    std::cout << "✅ Chybný tah odeslán hráči #" << playerNumber << std::endl;
+    LOG_DEBUG("✅ Chybný tah odeslán hráči #{}", playerNumber);
 }
 
 void GameManager::sendGameStateToPlayer(int playerNumber) {
-    std::cout << "📤 Posílám stav hry hráči #" << playerNumber << std::endl;
+    LOG_DEBUG("📤 Posílám stav hry hráči #{}", playerNumber);
+
+    // Bez rozdílu – delta klient dostane snímek naposledy rozeslané verze (např. po reconnectu)
+    StateUpdate update;
+    update.version = stateVersion;
+    update.full = Protocol::serializePayload(serializeGameState());
+    update.snapshot = Protocol::serializePayload(serializeStateDelta(stateVersion, 0, StateFields{}, lastState));
+    clientManager->sendStateToPlayers({playerNumber}, update);
+
+    LOG_DEBUG("✅ Stav hry odeslán hráči #{}", playerNumber);
+}
 
-    std::lock_guard<std::mutex> lock(gameMutex);
+void GameManager::broadcastGameState(const std::vector<int>& playerNumbers) {
+    LOG_DEBUG("📤 Posílám stav hry {} hráčům", playerNumbers.size());
 
+    // Odesílá se ze strandu místnosti – verze tak klientům dorazí v pořadí, v jakém vznikly
     std::vector<std::string> gameState = serializeGameState();
-    clientManager->sendToPlayer(playerNumber, Protocol::MessageType::STATE, gameState);
+    StateFields current{};
+    for (size_t i = 0; i < gameState.size() && i < STATE_FIELDS; i++) {
+        current[i] = gameState[i];
+    }
+
+    StateUpdate update;
+    update.version = ++stateVersion;
+    update.full = Protocol::serializePayload(gameState);
+    update.delta = Protocol::serializePayload(serializeStateDelta(update.version, update.version - 1, lastState, current));
+    update.snapshot = Protocol::serializePayload(serializeStateDelta(update.version, 0, StateFields{}, current));
+    lastState = std::move(current);
 
-    std::cout << "✅ Stav hry odeslán hráči #" << playerNumber << std::endl;
+    clientManager->sendStateToPlayers(playerNumbers, update);
+
+    LOG_DEBUG("✅ Stav hry odeslán (verze {})", update.version);
 }
 
 void GameManager::notifyActivePlayer() {
-    std::lock_guard<std::mutex> lock(gameMutex);
-
     if (!game) {
-        std::cerr << "⚠ Hra není inicializována" << std::endl;
+        LOG_WARN("⚠ Hra není inicializována");
         return;
     }
 
     int activePlayer = game->getActivePlayer()->getNumber();
 
-    std::cout << "🔔 Notifikuji hráče #" << activePlayer << " že je na tahu" << std::endl;
+    LOG_DEBUG("🔔 Notifikuji hráče #{} že je na tahu", activePlayer);
 
     std::vector<std::string> turnData;
     turnData.emplace_back("Je váš tah");
@@ -206,7 +265,38 @@ void GameManager::notifyActivePlayer() {
 
     clientManager->sendToPlayer(activePlayer, Protocol::MessageType::YOUR_TURN, turnData);
 
-    std::cout << "✅ YOUR_TURN odesláno hráči #" << activePlayer << std::endl;
+    LOG_DEBUG("✅ YOUR_TURN odesláno hráči #{}", activePlayer);
+}
+
+void GameManager::scheduleNotifyActivePlayer() {
+    scheduleEvent(BIDDING_NOTIFY_DELAY, [this] { notifyActivePlayer(); });
+}
+
+// ============================================================
+// ODLOŽENÉ UDÁLOSTI
+// ============================================================
+void GameManager::scheduleEvent(std::chrono::milliseconds delay, std::function<void()> action) {
+    // Časové kolo událost jen předá do strandu – provede se mezi ostatními událostmi místnosti
+    TimerWheel::TimerId eventId = timerWheel->schedule(delay, [this, action = std::move(action),
+                                                            token = timers.track()](TimerWheel::TimerId id) {
+        strand->post([this, id, action] {
+            if (scheduledEvents.erase(id) == 0) {
+                return;  // Událost byla mezitím zrušena
+            }
+
+            // Vše, co událost pošle (např. GAME_START a úvodní STATE), odejde každému hráči jedním zápisem
+            auto batch = networkManager->batch();
+            action();
+        });
+    });
+    scheduledEvents.insert(eventId);
+}
+
+void GameManager::cancelEvents() {
+    for (auto id : scheduledEvents) {
+        timerWheel->cancel(id);
+    }
+    scheduledEvents.clear();
 }
 
 // ============================================================
@@ -214,43 +304,31 @@ void GameManager::notifyActivePlayer() {
 // ============================================================
 
 void GameManager::handleTrick(ClientInfo* client) {
-    std::unique_lock<std::mutex> lock(trickMutex);
     trickResponses++;
 
-    std::cout << "✓ TRICK od hráče #" << client->playerNumber
-              << " (" << trickResponses << "/" << requiredPlayers << ")" << std::endl;
+    LOG_DEBUG("✓ TRICK od hráče #{} ({}/{})", client->playerNumber, trickResponses, requiredPlayers);
 
     if (trickResponses == requiredPlayers) {
-        std::cout << "🎯 Všichni hráči potvrdili štych" << std::endl;
-
-        {
-            std::lock_guard<std::mutex> gameLock(gameMutex);
-            game->resetTrick(game->getTrickWinner());
-        }
+        LOG_INFO("🎯 Všichni hráči potvrdili štych");
 
+        game->resetTrick(game->getTrickWinner());
         trickResponses = 0;
         notifyActivePlayer();
     }
 }
 
 void GameManager::handleBidding(std::string& label) {
-    {
-        std::cout << "Mění se stav hry..." << std::endl;
-        std::lock_guard<std::mutex> lock(gameMutex);
-        Card* card = nullptr;
-        game->gameHandler(*card, label);
-        std::cout << "Změna dokončena." << std::endl;
-    }
+    LOG_INFO("Mění se stav hry...");
+    Card* card = nullptr;
+    game->gameHandler(*card, label);
+    LOG_INFO("Změna dokončena.");
 
-    std::vector<Player*> players;
-    {
-        std::lock_guard<std::mutex> lock(gameMutex);
-        players = game->getPlayers();
+    std::vector<int> playerNumbers;
+    for (auto player : game->getPlayers()) {
+        playerNumbers.push_back(player->getNumber());
     }
 
-    for (auto player : players) {
-        sendGameStateToPlayer(player->getNumber());
-    }
+    broadcastGameState(playerNumbers);
 
     if (game->getState() == State::LICITACE_TALON) {
         std::string clientData = serializePlayer(game->getActivePlayer()->getNumber());
@@ -260,33 +338,18 @@ void GameManager::handleBidding(std::string& label) {
 
 void GameManager::handleCard(Card card) {
     std::string null;
-    bool result;
-    int actualActivePlayerNumber;
-    {
-        std::lock_guard<std::mutex> lock(gameMutex);
-        actualActivePlayerNumber = game->getActivePlayer()->getNumber();
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(gameMutex);
-        result = game->gameHandler(card, null);
-    }
+    int actualActivePlayerNumber = game->getActivePlayer()->getNumber();
+    bool result = game->gameHandler(card, null);
 
     if (result) {
-        std::vector<Player*> players;
-        {
-            std::lock_guard<std::mutex> lock(gameMutex);
-            players = game->getPlayers();
-        }
-
+        std::vector<Player*> players = game->getPlayers();
+        std::vector<int> playerNumbers;
         for (auto player : players) {
-            sendGameStateToPlayer(player->getNumber());
+            playerNumbers.push_back(player->getNumber());
         }
 
-        {
-            std::lock_guard<std::mutex> lock(gameMutex);
-            game->stateChanged = 0;
-        }
+        broadcastGameState(playerNumbers);
+        game->stateChanged = 0;
         std::string clientData = serializePlayer(actualActivePlayerNumber);
         clientManager->sendToPlayer(actualActivePlayerNumber, Protocol::MessageType::CLIENT_DATA, {clientData});
 
@@ -310,11 +373,7 @@ void GameManager::handleCard(Card card) {
             notifyActivePlayer();
         }
     } else {
-        int activePlayerNumber;
-        {
-            std::lock_guard<std::mutex> lock(gameMutex);
-            activePlayerNumber = game->getActivePlayer()->getNumber();
-        }
+        int activePlayerNumber = game->getActivePlayer()->getNumber();
         sendInvalidPlayer(activePlayerNumber);
         notifyActivePlayer();
     }
@@ -3,31 +3,50 @@
 
 #include "ClientManager.hpp"
 #include "Protocol.hpp"
+#include "Strand.hpp"
 #include "game/Game.hpp"
-#include <condition_variable>
-#include <mutex>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <unordered_set>
 
 class ClientManager;
 class NetworkManager;
 
+// Herní logika jedné místnosti. Všechny metody se volají jen ze strandu
+// místnosti (zprávy hráčů, odložené události, start hry), takže stav hry
+// nepotřebuje zámky.
 class GameManager {
 public:
-    GameManager(int requiredPlayers, NetworkManager* networkManager, ClientManager* clientManager);
+    GameManager(int requiredPlayers, NetworkManager* networkManager, ClientManager* clientManager,
+                TimerWheel* timerWheel, Strand* strand);
     ~GameManager();
 
-    void startGame();
+    void startGame(); // Pošle úvodní GAME_START, rozdání karet se naplánuje po WAITING_TIME
+    void hibernate(); // Uvolní stav hry prázdné místnosti (objekty místnosti zůstávají)
     void initPlayers();
 
+    // Stav pro souhrn místnosti (jen ze strandu)
+    int getStateCode() const;    // Hodnota State aktuální hry (-1 = žádná hra)
+    int getActivePlayer() const; // Číslo hráče na tahu (-1 = žádná hra)
+    bool hasPendingTimers() const { return !timers.idle(); } // Časové kolo ještě drží událost místnosti (libovolné vlákno)
+
     // Serializace
     std::vector<std::string> serializeGameStart(int playerNumber);
     std::vector<std::string> serializeGameState();
+    static constexpr size_t STATE_FIELDS = 8; // state|stateChanged|gameStarted|mode|trumph|isPlayedCards|cards|change_trick
+    using StateFields = std::array<std::string, STATE_FIELDS>;
+    static std::vector<std::string> serializeStateDelta(uint32_t version, uint32_t baseVersion,
+                                                        const StateFields& from, const StateFields& to); // version|baseVersion|index=hodnota|...
     std::string serializePlayer(int playerNumber);
     std::vector<std::string> serializeInvalid(int playerNumber);
 
     // Herní logika
     void sendGameStateToPlayer(int playerNumber);
+    void broadcastGameState(const std::vector<int>& playerNumbers); // Stav se serializuje jednou pro všechny hráče
     void sendInvalidPlayer(int playerNumber);
     void notifyActivePlayer();
+    void scheduleNotifyActivePlayer(); // YOUR_TURN po BIDDING_NOTIFY_DELAY (handler nečeká)
 
     // Handlery
     void handleTrick(ClientInfo* client);
@@ -35,15 +54,25 @@ public:
     void handleCard(Card card);
 
 private:
-    static constexpr int WAITING_TIME = 3;  // Doba čekání před začátkem hry
-    std::unique_ptr<NetworkManager> networkManager;
-    std::unique_ptr<ClientManager> clientManager;
+    static constexpr std::chrono::seconds WAITING_TIME{3};               // Doba čekání před začátkem hry
+    static constexpr std::chrono::milliseconds BIDDING_NOTIFY_DELAY{1000}; // Prodleva YOUR_TURN po licitaci
+    NetworkManager* networkManager;  // Nevlastní – patří serveru
+    ClientManager* clientManager;    // Nevlastní – patří místnosti
     int requiredPlayers;             // Požadovaný počet hráčů
     std::unique_ptr<Game> game;      // Instance hry
-    std::mutex gameMutex;            // Mutex pro thread-safe přístup ke hře
-    std::mutex trickMutex;           // Mutex pro thread-safe přístup ke štychu
-    std::condition_variable trickCV; // Podmíková promměná pro další štych
     int trickResponses = 0;          // Počet hráčů připravených na další štych
+    StateFields lastState{};         // Naposledy rozeslaný stav (základ pro STATE_DELTA)
+    uint32_t stateVersion = 0;       // Verze naposledy rozeslaného stavu
+
+    // Odložené herní události místnosti (časové kolo je předá do strandu)
+    TimerWheel* timerWheel;
+    Strand* strand;                  // Sériová fronta událostí místnosti
+    std::unordered_set<TimerWheel::TimerId> scheduledEvents; // Naplánované a dosud nespuštěné události
+    TimerWheel::Tracker timers;      // Události, které kolo ještě drží (i zrušené, jejichž callback právě běží)
+
+    void scheduleEvent(std::chrono::milliseconds delay, std::function<void()> action); // Naplánuje herní událost
+    void cancelEvents(); // Zruší všechny naplánované události místnosti
+    void dealAndStart(); // Rozdá karty a pošle GAME_START s daty a úvodní STATE
 };
 
 #endif
\ No newline at end of file
@@ -1,25 +1,40 @@
 #include "LobbyManager.hpp"
 #include "ClientManager.hpp"
 #include "GameManager.hpp"
-#include <iostream>
+#include "MessageHandler.hpp"
+#include "Metrics.hpp"
+#include "SessionPool.hpp"
+#include "Strand.hpp"
+#include "Logger.hpp"
+#include <algorithm>
 
 // ============================================================
 // LOBBY - Implementace struktury pro jednu herní místnost
 // ============================================================
 
-Lobby::Lobby(int lobbyId, int players, NetworkManager *netManager)
-    : id(lobbyId), gameStarted(false), requiredPlayers(players) {
+Lobby::Lobby(int lobbyId, int players, NetworkManager *netManager, TimerWheel *timerWheel,
+             WorkerPool *workerPool, SessionPool *sessionPool)
+    : id(lobbyId), gameStarted(false), requiredPlayers(players), openSeats(0),
+      hibernated(true), retired(false) {
 
-  clientManager = std::make_unique<ClientManager>(players, netManager);
-  gameManager =
-      std::make_unique<GameManager>(players, netManager, clientManager.get());
+  strand = std::make_unique<Strand>(workerPool);
+  clientManager = std::make_unique<ClientManager>(players, netManager, timerWheel, sessionPool,
+                                                  strand.get());
+  gameManager = std::make_unique<GameManager>(players, netManager, clientManager.get(),
+                                              timerWheel, strand.get());
+  messageHandler = std::make_unique<MessageHandler>(
+      netManager, clientManager.get(), gameManager.get());
 
-  std::cout << "🏠 Lobby #" << id << " vytvořena (" << players << " hráčů)"
-            << std::endl;
+  // Hra startuje událostí z autorizace/resetu – zpracuje ji strand místnosti
+  // mezi ostatními událostmi, takže start ani ukončení nepotřebují zámek
+  clientManager->setReadinessListener([this] { strand->post([this] { checkReadiness(); }); });
+  strand->setDrainListener([this] { publishSummary(); });
+
+  LOG_INFO("🏠 Lobby #{} vytvořena ({} hráčů)", id, players);
 }
 
 Lobby::~Lobby() {
-  std::cout << "🗑️ Lobby #" << id << " destruktor" << std::endl;
+  LOG_INFO("🗑️ Lobby #{} destruktor", id);
 }
 
 int Lobby::getConnectedCount() const {
@@ -30,51 +45,240 @@ int Lobby::getActiveCount() const { return clientManager->getActiveCount(); }
 
 bool Lobby::isFull() const { return getActiveCount() >= requiredPlayers; }
 
+void Lobby::checkReadiness() {
+  bool ready = clientManager->getActiveCount() == requiredPlayers &&
+               clientManager->getauthorizeCount() == requiredPlayers;
+
+  if (ready && !gameStarted) {
+    LOG_INFO("\n🎮 Lobby #{} - Všichni hráči připojeni!", id);
+    LOG_INFO("\n🚀 Lobby #{} - SPOUŠTÍM HRU!", id);
+    gameStarted = true;
+    gameManager->startGame();
+  } else if (gameStarted && clientManager->getauthorizeCount() < requiredPlayers) {
+    gameStarted = false;
+    LOG_INFO("\n🚀 Lobby #{} - Vypínám hru!", id);
+  }
+
+  hibernateIfIdle();
+}
+
+void Lobby::refreshIdle() {
+  // Volá se z notifikace obsazenosti libovolného vlákna – stav hry mění jen strand
+  strand->post([this] { hibernateIfIdle(); });
+}
+
+void Lobby::hibernateIfIdle() {
+  bool idle = getConnectedCount() == 0 && !gameStarted;
+
+  if (idle && !hibernated) {
+    // Objekty místnosti zůstávají pro další hráče, uvolní se jen stav hry
+    gameManager->hibernate();
+    hibernated = true;
+    LOG_INFO("💤 Lobby #{} uspána", id);
+  } else if (!idle && hibernated) {
+    hibernated = false;
+    LOG_INFO("☀️ Lobby #{} probuzena", id);
+  }
+}
+
+void Lobby::publishSummary() {
+  LobbySummary current;
+  current.id = id;
+  current.requiredPlayers = requiredPlayers;
+  current.connected = getConnectedCount();
+  current.active = getActiveCount();
+  current.authorized = clientManager->getauthorizeCount();
+  current.openSeats = openSeats;
+  current.gameStarted = gameStarted;
+  current.hibernated = hibernated;
+  current.gameState = gameManager->getStateCode();
+  current.activePlayer = gameManager->getActivePlayer();
+  current.version = ++summaryVersion;
+  summary.store(current);
+}
+
 bool Lobby::canJoin() const {
   // Může se připojit, pokud není plná nebo pokud hra ještě nezačala
   return !isFull();
 }
 
+bool Lobby::isIdle() const {
+  // Časovače před strandem – vypršený časovač stihne úlohu zařadit dřív, než ho kolo pustí
+  return getConnectedCount() == 0 && !gameStarted && hibernated &&
+         !clientManager->hasPendingTimers() && !gameManager->hasPendingTimers() && strand->isIdle();
+}
+
 // ============================================================
 // LOBBYMANAGER - Správce všech herních místností
 // ============================================================
 
-LobbyManager::LobbyManager(NetworkManager *netManager, int players,
-                           int lobbyCount)
-    : networkManager(netManager), requiredPlayers(players) {
+LobbyManager::LobbyManager(NetworkManager *netManager, TimerWheel *timerWheel,
+                           WorkerPool *workerPool, SessionPool *sessionPool, Metrics *metrics,
+                           int players, int maxLobbies)
+    : networkManager(netManager), timerWheel(timerWheel), workerPool(workerPool),
+      sessionPool(sessionPool), metrics(metrics),
+      requiredPlayers(players),
+      maxLobbies(maxLobbies), lobbyCount(0), openSeats(0) {
 
-  std::cout << "\n🏢 Vytvářím " << lobbyCount << " herních místností..."
-            << std::endl;
+  LOG_INFO("\n🏢 Místnosti se vytváří podle potřeby (bezpečnostní limit {})...", maxLobbies);
 
-  for (int i = 0; i < lobbyCount; i++) {
-    lobbies.push_back(std::make_unique<Lobby>(i + 1, players, netManager));
+  // Sloty i bitmapa mají pevnou velikost – vytvořené místnosti se nikdy nepřesouvají
+  lobbies.resize(maxLobbies);
+  freeSeats = std::vector<std::atomic<uint64_t>>((maxLobbies + 63) / 64);
+  for (auto &word : freeSeats) {
+    word.store(0);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(lobbiesMutex);
+    for (int i = 0; i < INITIAL_LOBBIES && lobbyCount < maxLobbies; i++) {
+      createLobby();
+    }
   }
+  ensureCapacity();
 
-  std::cout << "✅ Všechny místnosti vytvořeny\n" << std::endl;
+  LOG_INFO("✅ Vytvořeno {} místností\n", lobbyCount.load());
 }
 
 LobbyManager::~LobbyManager() {
-  std::cout << "🗑️ LobbyManager destruktor" << std::endl;
+  LOG_INFO("🗑️ LobbyManager destruktor");
   disconnectAll();
 }
 
-Lobby *LobbyManager::findAvailableLobby() {
+void LobbyManager::createLobby() {
+  size_t index = lobbyCount;
+  if (lobbies[index]) {
+    // Vyřazená, ještě nezrušená místnost se vrací do provozu
+    lobbies[index]->retired = false;
+  } else {
+    lobbies[index] = std::make_unique<Lobby>(static_cast<int>(index) + 1, requiredPlayers,
+                                             networkManager, timerWheel, workerPool, sessionPool);
+
+    // Index volných míst se aktualizuje při každém obsazení a uvolnění místa
+    lobbies[index]->clientManager->setSeatListener([this, index] { updateSeats(index); });
+    allocatedCount = std::max(allocatedCount, static_cast<int>(index) + 1);
+  }
+
+  // Publikace slotu – teprve potom může místnost dostat bit v bitmapě
+  lobbyCount.store(static_cast<int>(index) + 1, std::memory_order_release);
+  updateSeats(index);
+}
+
+void LobbyManager::retireLobby(size_t index) {
+  Lobby *lobby = lobbies[index].get();
+
+  // Příznak před smazáním bitu – souběžný updateSeats buď bit nenastaví, nebo ho sám smaže
+  lobby->retired = true;
+  lobby->retiredAt = std::chrono::steady_clock::now();
+  clearSeats(lobby, index);
+  lobbyCount.store(static_cast<int>(index), std::memory_order_release);
+
+  int lobbyTotal = lobbyCount.load(std::memory_order_acquire);
+  int totalOpen = openSeats.load();
+  metrics->setOccupancy(lobbyTotal, lobbyTotal * requiredPlayers - totalOpen, totalOpen);
+  LOG_INFO("📉 Lobby #{} vyřazena, místností: {}, volných míst: {}", lobby->id, lobbyTotal, totalOpen);
+}
+
+void LobbyManager::clearSeats(Lobby *lobby, size_t index) {
+  freeSeats[index / 64].fetch_and(~(1ull << (index % 64)));
+  openSeats -= lobby->openSeats.exchange(0);
+}
+
+void LobbyManager::reclaimIdle() {
   std::lock_guard<std::mutex> lock(lobbiesMutex);
 
-  // Hledáme první volnou místnost
-  for (auto &lobby : lobbies) {
-    if (lobby->canJoin()) {
-      return lobby.get();
+  // Přebytečné prázdné místnosti shora – hranice volných míst musí platit i bez nich
+  int watermark = SPARE_LOBBIES * requiredPlayers;
+  while (lobbyCount > INITIAL_LOBBIES) {
+    size_t index = static_cast<size_t>(lobbyCount - 1);
+    Lobby *lobby = lobbies[index].get();
+    if (!lobby->isIdle() || openSeats - lobby->openSeats < watermark) {
+      break;
+    }
+    retireLobby(index);
+  }
+
+  // Zrušení místností vyřazených déle než RECLAIM_GRACE. Bezpečné je až podle isIdle():
+  // kolo nedrží žádný callback místnosti a strand nemá úlohu ani nedobíhající dávku.
+  // Vyřazená místnost nové hráče nedostane, takže už nic nového nenaplánuje.
+  auto now = std::chrono::steady_clock::now();
+  for (int i = lobbyCount; i < allocatedCount; i++) {
+    Lobby *lobby = lobbies[i].get();
+    if (lobby && now - lobby->retiredAt >= RECLAIM_GRACE && lobby->isIdle()) {
+      lobbies[i].reset();
+    }
+  }
+  while (allocatedCount > lobbyCount && !lobbies[allocatedCount - 1]) {
+    allocatedCount--;
+  }
+}
+
+void LobbyManager::ensureCapacity() {
+  int watermark = SPARE_LOBBIES * requiredPlayers;
+  if (openSeats.load(std::memory_order_acquire) >= watermark) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(lobbiesMutex);
+  while (openSeats < watermark && lobbyCount < maxLobbies) {
+    createLobby();
+    LOG_INFO("📈 Přidána Lobby #{} ({}/{}), volných míst: {}", lobbyCount.load(), lobbyCount.load(), maxLobbies, openSeats.load());
+  }
+}
+
+Lobby *LobbyManager::findAvailableLobby() {
+  // První místnost s volným místem podle bitmapy – bez zámků a procházení klientů.
+  // Nižší místnosti mají přednost, takže vyšší zůstávají uspané.
+  size_t words = (static_cast<size_t>(lobbyCount.load(std::memory_order_acquire)) + 63) / 64;
+  for (size_t word = 0; word < words; word++) {
+    uint64_t bits = freeSeats[word].load(std::memory_order_acquire);
+    while (bits != 0) {
+      size_t index = word * 64 + __builtin_ctzll(bits);
+      Lobby *lobby = lobbies[index].get();
+      if (!lobby->retired) {
+        return lobby;
+      }
+      bits &= bits - 1;  // Bit vyřazené místnosti za okamžik smaže její updateSeats
     }
   }
 
   return nullptr;
 }
 
+void LobbyManager::updateSeats(size_t index) {
+  Lobby *lobby = lobbies[index].get();
+  std::atomic<uint64_t> &word = freeSeats[index / 64];
+  uint64_t bit = 1ull << (index % 64);
+
+  // Souběžná změna mohla zapsat zastaralý stav – po zápisu ověříme a případně opravíme
+  int open;
+  do {
+    open = std::max(0, requiredPlayers - lobby->getActiveCount());
+    openSeats += open - lobby->openSeats.exchange(open);
+    if (open > 0) {
+      word.fetch_or(bit, std::memory_order_release);
+    } else {
+      word.fetch_and(~bit, std::memory_order_release);
+    }
+  } while (std::max(0, requiredPlayers - lobby->getActiveCount()) != open);
+
+  // Místnost byla mezitím vyřazena – její místa se nepočítají a bit nesmí zůstat
+  if (lobby->retired) {
+    clearSeats(lobby, index);
+    return;
+  }
+
+  int lobbyTotal = lobbyCount.load(std::memory_order_acquire);
+  int totalOpen = openSeats.load();
+  metrics->setOccupancy(lobbyTotal, lobbyTotal * requiredPlayers - totalOpen, totalOpen);
+
+  lobby->refreshIdle();
+}
+
 Lobby *LobbyManager::getLobby(int lobbyId) {
   std::lock_guard<std::mutex> lock(lobbiesMutex);
 
-  if (lobbyId < 1 || lobbyId > static_cast<int>(lobbies.size())) {
+  if (lobbyId < 1 || lobbyId > lobbyCount) {
     return nullptr;
   }
 
@@ -86,27 +290,64 @@ std::string LobbyManager::getLobbiesStatus() {
 
   std::string status = "\n📊 STAV MÍSTNOSTÍ:\n";
   status += std::string(40, '=') + "\n";
+  status += "Místnosti: " + std::to_string(lobbyCount) + "/" + std::to_string(maxLobbies) +
+            ", volná místa: " + std::to_string(openSeats) + ", relace: " +
+            std::to_string(sessionPool->getInUse()) + "/" + std::to_string(sessionPool->getCapacity()) +
+            "\n";
 
-  for (const auto &lobby : lobbies) {
+  for (int i = 0; i < lobbyCount; i++) {
+    const auto &lobby = lobbies[i];
     status += "Lobby #" + std::to_string(lobby->id) + ": ";
     status += std::to_string(lobby->getActiveCount()) + "/" +
               std::to_string(lobby->requiredPlayers);
-    status += (lobby->gameStarted ? " (hra běží)" : " (čeká)");
+    if (lobby->gameStarted) {
+      status += " (hra běží)";
+    } else if (lobby->hibernated) {
+      status += " (uspaná)";
+    } else {
+      status += " (čeká)";
+    }
+    status += " | schránka " + std::to_string(lobby->strand->getDepth()) + " (max " +
+              std::to_string(lobby->strand->getPeakDepth()) + ")";
+    if (lobby->strand->getRejectedCount() > 0) {
+      status += ", odmítnuto " + std::to_string(lobby->strand->getRejectedCount());
+    }
     status += "\n";
   }
 
+  status += metrics->getSummary();
   status += std::string(40, '=') + "\n";
   return status;
 }
 
+std::vector<LobbySummary> LobbyManager::getSummaries() const {
+  // Zámek jen kvůli rušení vyřazených místností (drží ho krátce vlákno accept);
+  // samotné souhrny se čtou bez zámku (SeqLock)
+  std::lock_guard<std::mutex> lock(lobbiesMutex);
+  int count = lobbyCount.load(std::memory_order_acquire);
+
+  std::vector<LobbySummary> summaries;
+  summaries.reserve(count);
+  for (int i = 0; i < count; i++) {
+    LobbySummary current = lobbies[i]->getSummary();
+    current.id = lobbies[i]->id;  // Místnost bez první dávky ještě nic nezveřejnila
+    current.requiredPlayers = requiredPlayers;
+    current.inboxDepth = lobbies[i]->strand->getDepth();
+    current.inboxPeak = lobbies[i]->strand->getPeakDepth();
+    current.rejected = lobbies[i]->strand->getRejectedCount();
+    summaries.push_back(current);
+  }
+  return summaries;
+}
+
 void LobbyManager::disconnectAll() {
   std::lock_guard<std::mutex> lock(lobbiesMutex);
 
-  std::cout << "🔌 Odpojuji všechny hráče ze všech místností..." << std::endl;
+  LOG_INFO("🔌 Odpojuji všechny hráče ze všech místností...");
 
-  for (auto &lobby : lobbies) {
-    if (lobby->clientManager) {
-      lobby->clientManager->disconnectAll();
+  for (int i = 0; i < lobbyCount; i++) {
+    if (lobbies[i]->clientManager) {
+      lobbies[i]->clientManager->disconnectAll();
     }
   }
 }
\ No newline at end of file
@@ -1,48 +1,132 @@
 #ifndef LOBBYMANAGER_HPP
 #define LOBBYMANAGER_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "SeqLock.hpp"
 
 // Forward deklarace
 class NetworkManager;
 class ClientManager;
 class GameManager;
+class MessageHandler;
+class TimerWheel;
+class WorkerPool;
+class Strand;
+class SessionPool;
+class Metrics;
+
+// Souhrn místnosti pro admin rozhraní. Zveřejňuje ho strand po každé dávce
+// událostí, čtenář si ho vezme bez zámku (SeqLock) – herní cestu nezdržuje.
+struct LobbySummary {
+  int id = 0;               // ID místnosti
+  int requiredPlayers = 0;  // Počet míst
+  int connected = 0;        // Připojení klienti (včetně čekajících na reconnect)
+  int active = 0;           // Aktivní hráči
+  int authorized = 0;       // Autorizovaní hráči
+  int openSeats = 0;        // Volná místa
+  bool gameStarted = false; // Hra běží
+  bool hibernated = false;  // Místnost je uspaná
+  int gameState = -1;       // Hodnota State (-1 = žádná hra)
+  int activePlayer = -1;    // Hráč na tahu (-1 = žádná hra)
+  uint64_t version = 0;     // Počet zveřejnění
+
+  // Živé hodnoty schránky (doplní getSummaries z atomických čítačů strandu)
+  uint64_t inboxDepth = 0;  // Čekající úlohy
+  uint64_t inboxPeak = 0;   // Nejvyšší hloubka
+  uint64_t rejected = 0;    // Odmítnuté zprávy
+};
 
 struct Lobby {
+  std::unique_ptr<Strand> strand; // Sériová fronta událostí místnosti (hra, start, uspání)
   std::unique_ptr<ClientManager> clientManager;
   std::unique_ptr<GameManager> gameManager;
+  std::unique_ptr<MessageHandler> messageHandler; // Zpracování zpráv hráčů v lobby
   int id;              // ID místnosti
-  bool gameStarted;    // Příznak pro začátek hry
+  std::atomic<bool> gameStarted; // Příznak pro začátek hry
   int requiredPlayers; // Počet požadovaných hráčů
+  std::atomic<int> openSeats;    // Volná místa započtená do součtu LobbyManageru
+  std::atomic<bool> hibernated;  // Prázdná místnost bez hry – čeká na znovupoužití
+  std::atomic<bool> retired;     // Místnost je vyřazená z počtu (nedostává hráče), čeká na zrušení
+  std::chrono::steady_clock::time_point retiredAt; // Čas vyřazení (jen vlákno accept)
 
-  Lobby(int lobbyId, int players, NetworkManager *netManager);
+  Lobby(int lobbyId, int players, NetworkManager *netManager, TimerWheel *timerWheel,
+        WorkerPool *workerPool, SessionPool *sessionPool);
   ~Lobby();
 
   int getConnectedCount() const; // Vrátí počet připojených hráčů v lobby
   int getActiveCount() const;    // Vrátí počet aktivních hráčů
   bool isFull() const;           // Zjistí zda je lobby plně obsazené
   bool canJoin() const;          // Příznak zda se může klient připojit do lobby
+  bool isIdle() const;           // Bez klientů, bez hry, bez časovačů a bez čekajících událostí
+  void checkReadiness();         // Spustí hru, jakmile jsou všichni připraveni (běží ve strandu)
+  void refreshIdle();            // Zařadí do strandu uspání prázdné místnosti (nebo probuzení)
+  LobbySummary getSummary() const { return summary.load(); } // Naposledy zveřejněný souhrn (bez zámku)
+
+private:
+  SeqLock<LobbySummary> summary; // Souhrn pro admin rozhraní (zapisuje jen strand)
+  uint64_t summaryVersion = 0;   // Počet zveřejnění (jen strand)
+
+  void hibernateIfIdle();        // Běží ve strandu
+  void publishSummary();         // Běží ve strandu po každé dávce
 };
 
+// Místnosti vznikají podle poptávky – při startu jen INITIAL_LOBBIES, další se
+// vytvoří, jakmile volná místa klesnou pod SPARE_LOBBIES místností. maxLobbies
+// (-l) je jen bezpečnostní limit; sloty jsou na něj rezervované dopředu, takže
+// ukazatele na místnosti (a bitmapa) zůstávají platné. Prázdná místnost se
+// nejdřív uspí; je-li volných míst víc, než kolik hranice vyžaduje, vyřadí se
+// z počtu (shora – hráči se usazují odspodu) a po RECLAIM_GRACE se zruší.
+// Vyřazování i usazování hráčů běží jen na vlákně accept, takže se nepotkají.
 class LobbyManager {
+public:
+  static constexpr int MAX_LOBBIES = 65536; // Výchozí bezpečnostní limit počtu místností
+  static constexpr auto RECLAIM_INTERVAL = std::chrono::seconds(1); // Perioda reclaimIdle na vlákně accept
+
 private:
+  static constexpr int INITIAL_LOBBIES = 1; // Počet místností vytvořených při startu
+  static constexpr int SPARE_LOBBIES = 1;   // Hranice volných míst (v celých místnostech)
+  static constexpr auto RECLAIM_GRACE = std::chrono::seconds(5); // Od vyřazení do zrušení (místnost se může vrátit do provozu)
+
   NetworkManager *networkManager;
+  TimerWheel *timerWheel;
+  WorkerPool *workerPool;                      // Sdílená vlákna pro strandy místností
+  SessionPool *sessionPool;                    // Sdílené sloty relací klientů
+  Metrics *metrics;                            // Obsazenost místností a souhrn pro výpis stavu
   int requiredPlayers;                         // Počet požadovaných hráčů
-  std::vector<std::unique_ptr<Lobby>> lobbies; // Pole místností
-  std::mutex lobbiesMutex;                     // Mutex pro přístup do místností
+  int maxLobbies;                              // Bezpečnostní limit počtu místností
+  std::vector<std::unique_ptr<Lobby>> lobbies; // Sloty místností (prvních lobbyCount je v provozu, nad nimi vyřazené)
+  int allocatedCount = 0;                      // Sloty s objektem místnosti (vyžaduje lobbiesMutex)
+  std::atomic<int> lobbyCount;                 // Počet vytvořených místností
+  std::atomic<int> openSeats;                  // Volná místa ve všech vytvořených místnostech
+  mutable std::mutex lobbiesMutex;             // Mutex pro vytváření, vyřazování a procházení místností
+  std::vector<std::atomic<uint64_t>> freeSeats; // Bitmapa místností s volným místem (bit = index místnosti)
+
+  void updateSeats(size_t index); // Přepočítá bit místnosti a součet volných míst
+  void createLobby();             // Vytvoří (nebo vrátí do provozu vyřazenou) další místnost (vyžaduje lobbiesMutex)
+  void retireLobby(size_t index); // Vyřadí nejvyšší místnost z počtu (vyžaduje lobbiesMutex)
+  void clearSeats(Lobby *lobby, size_t index); // Odebere místnost z bitmapy a součtu volných míst
 
 public:
-  LobbyManager(NetworkManager *netManager, int players, int lobbyCount);
+  LobbyManager(NetworkManager *netManager, TimerWheel *timerWheel, WorkerPool *workerPool,
+               SessionPool *sessionPool, Metrics *metrics, int players, int maxLobbies);
   ~LobbyManager();
   Lobby *findAvailableLobby();    // Najde volnou místnost pro nového hráče
   Lobby *getLobby(int lobbyId);   // Najde místnost podle ID
+  void ensureCapacity();          // Doplní místnosti, pokud volná místa klesla pod hranici
+  void reclaimIdle();             // Vyřadí přebytečné prázdné místnosti a zruší dávno vyřazené (vlákno accept)
   std::string getLobbiesStatus(); // Získá statistiky všech místností
-  int getLobbyCount() const { return lobbies.size(); } // Počet místností
+  std::vector<LobbySummary> getSummaries() const; // Souhrny místností v provozu (souhrny bez zámku)
+  int getOpenSeats() const { return openSeats; }  // Volná místa ve vytvořených místnostech
+  int getLobbyCount() const { return lobbyCount; } // Počet místností v provozu
+  int getMaxLobbies() const { return maxLobbies; } // Bezpečnostní limit počtu místností
   void disconnectAll(); // Odpojí všechny klienty ze všech místností
 };
 
@@ -0,0 +1,257 @@
+#include "Logger.hpp"
+
+#include <cstdio>
+#include <ctime>
+
+namespace {
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(5);      // Spánek zapisovače bez práce
+    constexpr auto FLUSH_TIMEOUT = std::chrono::milliseconds(1000); // Max. čekání ve flush()
+    constexpr size_t BATCH_LIMIT = 4096;                           // Max. záznamů v jedné dávce
+
+    const char* levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::TRACE: return "TRACE";
+            case LogLevel::DEBUG: return "DEBUG";
+            case LogLevel::INFO:  return "INFO ";
+            case LogLevel::WARN:  return "WARN ";
+            case LogLevel::ERROR: return "ERROR";
+            default:              return "?    ";
+        }
+    }
+}
+
+// Výchozí úroveň INFO – záznamy po paketech (DEBUG) se zapínají přes -v debug
+std::atomic<int> Logger::minLevel{static_cast<int>(LogLevel::INFO)};
+
+// ============================================================
+// ŽIVOTNÍ CYKLUS
+// ============================================================
+Logger& Logger::instance() {
+    // Záměrně se neuvolní – loguje se i z vláken, která doběhnou až při ukončení
+    static Logger* logger = new Logger();
+    return *logger;
+}
+
+Logger::Logger()
+    : startSteady(std::chrono::steady_clock::now().time_since_epoch().count()),
+      startSystem(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count()) {
+    running = true;
+    writer = std::thread(&Logger::run, this);
+}
+
+void Logger::setLevel(LogLevel level) {
+    minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+bool Logger::parseLevel(std::string_view name, LogLevel& level) {
+    static constexpr std::pair<std::string_view, LogLevel> names[] = {
+        {"trace", LogLevel::TRACE}, {"debug", LogLevel::DEBUG}, {"info", LogLevel::INFO},
+        {"warn", LogLevel::WARN},   {"error", LogLevel::ERROR}, {"off", LogLevel::OFF},
+    };
+    for (const auto& [candidate, value] : names) {
+        if (candidate == name) {
+            level = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::flush() {
+    if (!running.load()) {
+        return;
+    }
+
+    // Prázdný průchod, který začal až po tomto volání, znamená vypsáno vše starší
+    std::unique_lock<std::mutex> lock(writerMutex);
+    uint64_t target = emptyRounds + 2;
+    writerWakeup.notify_one();
+    writerIdle.wait_for(lock, FLUSH_TIMEOUT, [this, target] {
+        return emptyRounds >= target || !running.load();
+    });
+}
+
+void Logger::shutdown() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    writerWakeup.notify_one();
+    if (writer.joinable() && writer.get_id() != std::this_thread::get_id()) {
+        writer.join();
+    }
+}
+
+// ============================================================
+// BUFFERY VLÁKEN
+// ============================================================
+Logger::Ring& Logger::localRing() {
+    // Při konci vlákna se buffer jen označí – zapisovač ho vyprázdní a uvolní
+    struct Handle {
+        std::shared_ptr<Ring> ring;
+        ~Handle() {
+            if (ring) {
+                ring->orphaned.store(true, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Handle handle;
+
+    if (!handle.ring) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        handle.ring = std::make_shared<Ring>(nextRingId++);
+        rings.push_back(handle.ring);
+    }
+    return *handle.ring;
+}
+
+// ============================================================
+// ZAPISOVAČ
+// ============================================================
+void Logger::run() {
+    while (running.load()) {
+        if (writeBatch()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(writerMutex);
+        emptyRounds++;
+        writerIdle.notify_all();
+        writerWakeup.wait_for(lock, IDLE_WAIT);
+    }
+
+    // Dopsat, co vlákna stihla zalogovat před ukončením (omezeně – mohou logovat dál)
+    for (int round = 0; round < 16 && writeBatch(); round++) {
+    }
+    writerIdle.notify_all();
+}
+
+bool Logger::writeBatch() {
+    std::vector<std::shared_ptr<Ring>> current;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        current = rings;
+    }
+
+    // Záznamy se čtou přímo z bufferů – hlavy se posunou až po vypsání
+    std::vector<const Record*> batch;
+    std::vector<std::pair<Ring*, size_t>> consumed;
+    uint64_t dropped = 0;
+    bool orphans = false;
+
+    for (const auto& ring : current) {
+        bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        size_t tail = ring->tail.load(std::memory_order_acquire);
+        size_t end = std::min(tail, head + (BATCH_LIMIT - std::min(batch.size(), BATCH_LIMIT)));
+
+        for (size_t position = head; position < end; position++) {
+            batch.push_back(&ring->slots[position & (RING_SLOTS - 1)]);
+        }
+        consumed.emplace_back(ring.get(), end);
+        dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+        orphans = orphans || (orphaned && end == tail);
+    }
+
+    if (batch.empty() && dropped == 0) {
+        if (orphans) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<Ring>& ring) {
+                return ring->orphaned.load(std::memory_order_acquire) &&
+                       ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_acquire);
+            }), rings.end());
+        }
+        return false;
+    }
+
+    // Sloučení vláken podle času zápisu
+    std::stable_sort(batch.begin(), batch.end(), [](const Record* a, const Record* b) {
+        return a->timestamp < b->timestamp;
+    });
+
+    std::string out;
+    std::string err;
+    for (const Record* record : batch) {
+        render(*record, record->level >= LogLevel::WARN ? err : out);
+    }
+    if (dropped > 0) {
+        err += "⚠️  Logger: zahozeno " + std::to_string(dropped) + " řádků (plný buffer vlákna)\n";
+    }
+
+    for (const auto& [ring, end] : consumed) {
+        ring->head.store(end, std::memory_order_release);
+    }
+
+    if (!out.empty()) {
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+    }
+    if (!err.empty()) {
+        std::fwrite(err.data(), 1, err.size(), stderr);
+        std::fflush(stderr);
+    }
+    return true;
+}
+
+void Logger::render(const Record& record, std::string& out) const {
+    const char* format = record.format;
+
+    // Úvodní prázdné řádky formátu patří před prefix
+    while (*format == '\n') {
+        out += '\n';
+        format++;
+    }
+
+    int64_t wall = startSystem + (record.timestamp - startSteady);
+    std::time_t seconds = static_cast<std::time_t>(wall / 1000000000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+
+    char prefix[48];
+    std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%06d %s [t%u] ",
+                  local.tm_hour, local.tm_min, local.tm_sec,
+                  static_cast<int>((wall % 1000000000) / 1000), levelName(record.level), record.thread);
+    out += prefix;
+
+    size_t arg = 0;
+    for (const char* c = format; *c != '\0'; c++) {
+        if (c[0] != '{' || c[1] != '}' || arg >= record.argCount) {
+            out += *c;
+            continue;
+        }
+
+        uint64_t value = record.values[arg];
+        char number[32];
+        switch (record.types[arg]) {
+            case ArgType::INT:
+                out += std::to_string(static_cast<int64_t>(value));
+                break;
+            case ArgType::UINT:
+                out += std::to_string(value);
+                break;
+            case ArgType::DOUBLE: {
+                double real;
+                std::memcpy(&real, &value, sizeof(real));
+                std::snprintf(number, sizeof(number), "%g", real);
+                out += number;
+                break;
+            }
+            case ArgType::BOOL:
+                out += value ? "1" : "0";
+                break;
+            case ArgType::CHAR:
+                out += static_cast<char>(value);
+                break;
+            case ArgType::STRING:
+                out.append(record.text + (value >> 32), value & 0xFFFFFFFF);
+                break;
+        }
+        arg++;
+        c++;
+    }
+
+    // Zprávy a formáty s vlastním koncem řádku nedostanou další
+    if (out.back() != '\n') {
+        out += '\n';
+    }
+}
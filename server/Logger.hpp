@@ -0,0 +1,190 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Úrovně logu (vzestupně podle závažnosti)
+enum class LogLevel : int {
+    TRACE = 0,
+    DEBUG = 1,
+    INFO = 2,
+    WARN = 3,
+    ERROR = 4,
+    OFF = 5,
+};
+
+// Nejnižší zakompilovaná úroveň – např. -DLOG_COMPILE_LEVEL=2 vypustí TRACE a DEBUG
+// řádky z binárky úplně (argumenty se ani nevyhodnotí)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+// Asynchronní logger. Vlákno zapíše řádek do vlastního lock-free kruhového
+// bufferu jako binární záznam (ukazatel na formát + hodnoty argumentů, řetězce
+// se zkopírují) a hned pokračuje. Text vzniká až ve vlákně zapisovače, které
+// buffery všech vláken slučuje podle času a vypisuje po dávkách.
+// Formát používá "{}" jako místo pro další argument; formát musí být literál.
+// Plný buffer řádek zahodí (hot path nikdy nečeká) a zapisovač ztráty ohlásí.
+class Logger {
+public:
+    static constexpr size_t MAX_ARGS = 8;       // Max. argumentů jednoho řádku
+    static constexpr size_t TEXT_BYTES = 384;   // Místo pro kopie řetězcových argumentů v záznamu
+    static constexpr size_t RING_SLOTS = 1024;  // Záznamů v bufferu jednoho vlákna (mocnina dvou)
+
+    static Logger& instance(); // Jediná instance (zapisovač se spustí při prvním použití)
+
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level);                          // Runtime filtr
+    static bool parseLevel(std::string_view name, LogLevel& level); // "trace", "debug", ... "off"
+
+    template <typename... Args>
+    void log(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Příliš mnoho argumentů logu");
+
+        Ring& ring = localRing();
+        Record* record = ring.beginWrite();
+        if (!record) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        record->format = format;
+        record->timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        record->level = level;
+        record->argCount = 0;
+        record->textUsed = 0;
+        (encode(*record, args), ...);
+
+        ring.commit();
+    }
+
+    void flush();    // Počká, než zapisovač vypíše vše zalogované do této chvíle
+    void shutdown(); // Vypíše zbytek a zastaví zapisovač (další řádky se už nevypíší)
+
+private:
+    enum class ArgType : uint8_t { INT, UINT, DOUBLE, BOOL, CHAR, STRING };
+
+    // Binární záznam jednoho řádku – text se z něj skládá až při výpisu
+    struct Record {
+        const char* format;                    // Literál formátu
+        int64_t timestamp;                     // steady_clock v ns
+        LogLevel level;
+        uint8_t argCount;
+        uint16_t textUsed;                     // Obsazená část text
+        uint32_t thread;                       // Číslo vlákna (pořadí registrace)
+        std::array<ArgType, MAX_ARGS> types;
+        std::array<uint64_t, MAX_ARGS> values; // Číslo, nebo (offset << 32 | délka) řetězce v text
+        char text[TEXT_BYTES];
+    };
+
+    // Kruhový buffer jednoho vlákna (jeden producent, jeden konzument)
+    struct Ring {
+        explicit Ring(uint32_t id) : slots(std::make_unique<Record[]>(RING_SLOTS)), id(id) {}
+
+        Record* beginWrite() {
+            size_t position = tail.load(std::memory_order_relaxed);
+            if (position - head.load(std::memory_order_acquire) >= RING_SLOTS) {
+                return nullptr;
+            }
+            Record* record = &slots[position & (RING_SLOTS - 1)];
+            record->thread = id;
+            return record;
+        }
+        void commit() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        std::unique_ptr<Record[]> slots;
+        uint32_t id;
+        alignas(64) std::atomic<size_t> head{0};   // Čte jen zapisovač
+        alignas(64) std::atomic<size_t> tail{0};   // Zapisuje jen vlastník
+        std::atomic<uint64_t> dropped{0};          // Řádky zahozené pro plný buffer
+        std::atomic<bool> orphaned{false};         // Vlákno skončilo – po vyprázdnění se buffer uvolní
+    };
+
+    static std::atomic<int> minLevel;
+
+    std::mutex registryMutex;                  // Registrace bufferů (jen při prvním logu vlákna)
+    std::vector<std::shared_ptr<Ring>> rings;  // Buffery všech vláken
+    uint32_t nextRingId = 0;
+
+    std::mutex writerMutex;                    // Probouzení a čekání na zapisovač
+    std::condition_variable writerWakeup;
+    std::condition_variable writerIdle;        // flush() čeká na prázdnou dávku
+    uint64_t emptyRounds = 0;                  // Počet průchodů bez záznamů (pod writerMutex)
+    std::atomic<bool> running{false};
+    std::thread writer;
+    int64_t startSteady;                       // Časová osa pro převod na čas dne
+    int64_t startSystem;
+
+    Logger();
+    Ring& localRing();
+    void run();                                // Smyčka zapisovače
+    bool writeBatch();                         // Jedna dávka – false, pokud nebylo co psát
+    void render(const Record& record, std::string& out) const;
+
+    // ===== Kódování argumentů =====
+    template <typename T>
+    static void encode(Record& record, const T& value) {
+        size_t index = record.argCount++;
+        if constexpr (std::is_same_v<T, bool>) {
+            record.types[index] = ArgType::BOOL;
+            record.values[index] = value ? 1 : 0;
+        } else if constexpr (std::is_same_v<T, char>) {
+            record.types[index] = ArgType::CHAR;
+            record.values[index] = static_cast<unsigned char>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            record.types[index] = ArgType::INT;
+            record.values[index] = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            record.types[index] = ArgType::UINT;
+            record.values[index] = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            double number = static_cast<double>(value);
+            record.types[index] = ArgType::DOUBLE;
+            std::memcpy(&record.values[index], &number, sizeof(number));
+        } else {
+            encodeText(record, index, std::string_view(value));
+        }
+    }
+
+    // Řetězec se zkopíruje do záznamu (nevejde-li se, zkrátí se)
+    static void encodeText(Record& record, size_t index, std::string_view text) {
+        size_t length = std::min(text.size(), TEXT_BYTES - record.textUsed);
+        std::memcpy(record.text + record.textUsed, text.data(), length);
+        record.types[index] = ArgType::STRING;
+        record.values[index] = (static_cast<uint64_t>(record.textUsed) << 32) | length;
+        record.textUsed = static_cast<uint16_t>(record.textUsed + length);
+    }
+};
+
+#define LOG_AT(level, ...)                                                  \
+    do {                                                                    \
+        if constexpr (static_cast<int>(level) >= LOG_COMPILE_LEVEL) {       \
+            if (Logger::enabled(level)) {                                   \
+                Logger::instance().log(level, __VA_ARGS__);                 \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_AT(LogLevel::TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERROR, __VA_ARGS__)
+
+#endif // LOGGER_HPP
@@ -1,8 +1,11 @@
 #include "Server.hpp"
+#include "Logger.hpp"
 #include <iostream>
 #include <csignal>
 #include <cstring>
+#include <algorithm>
 #include <regex>
+#include <thread>
 
 // Globální ukazatel na server pro signal handler
 GameServer* globalServer = nullptr;
@@ -15,6 +18,8 @@ void signalHandler(int signum) {
         globalServer->stop();
     }
 
+    // Vypsat zbytek logu, než proces skončí
+    Logger::instance().shutdown();
     exit(signum);
 }
 
@@ -23,14 +28,18 @@ void printUsage(const char* programName) {
     std::cout << "Volby:\n";
     std::cout << "  -i IP        IP adresa serveru (výchozí: 0.0.0.0 = všechna rozhraní)\n";
     std::cout << "  -p PORT      Port serveru (výchozí: 10000)\n";
-    std::cout << "  -l LOBBIES   Počet herních místností (výchozí: 1)\n";
+    std::cout << "  -l LOBBIES   Bezpečnostní limit počtu místností – vytváří a ruší se podle potřeby (výchozí: " << LobbyManager::MAX_LOBBIES << ")\n";
     std::cout << "  -n PLAYERS   Počet hráčů na místnost (výchozí: 2)\n";
+    std::cout << "  -t THREADS   Počet I/O vláken obsluhujících klienty (výchozí: 2)\n";
+    std::cout << "  -w WORKERS   Počet herních vláken sdílených místnostmi (výchozí: počet jader)\n";
+    std::cout << "  -a PORT      Admin rozhraní na 127.0.0.1:PORT – /stats (JSON), /metrics (Prometheus) (výchozí: vypnuto)\n";
+    std::cout << "  -v LEVEL     Úroveň logu: trace, debug, info, warn, error, off (výchozí: info)\n";
     std::cout << "  -h           Zobrazit tuto nápovědu\n\n";
     std::cout << "Příklady:\n";
     std::cout << "  " << programName << "                        # Výchozí nastavení (0.0.0.0:10000)\n";
     std::cout << "  " << programName << " -i 127.0.0.1           # Pouze localhost\n";
     std::cout << "  " << programName << " -i 192.168.1.100 -p 8080  # Konkrétní IP a port\n";
-    std::cout << "  " << programName << " -p 9000 -l 2 -n 4      # 2 místnosti po 4 hráčích\n";
+    std::cout << "  " << programName << " -p 9000 -l 2 -n 3      # Nejvýše 2 místnosti po 3 hráčích\n";
     std::cout << "\n";
     std::cout << "💡 Vysvětlení IP adres:\n";
     std::cout << "  0.0.0.0      - Naslouchá na VŠECH síťových rozhraních (LAN + localhost)\n";
@@ -42,8 +51,11 @@ int main(int argc, char* argv[]) {
     // Výchozí hodnoty
     std::string ip = "0.0.0.0";  // 0.0.0.0 = naslouchá na všech rozhraních
     int port = 10000;
-    int lobbies = 1;
+    int lobbies = LobbyManager::MAX_LOBBIES; // Jen bezpečnostní limit, místnosti rostou podle poptávky
     int players = 2;
+    int ioThreads = 2;
+    int gameThreads = std::max(1u, std::thread::hardware_concurrency()); // Herní vlákna na všechna jádra
+    int adminPort = 0; // 0 = admin rozhraní vypnuto
 
     const std::regex ip_regex("^((25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)\\.){3}(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)$");
 
@@ -75,8 +87,8 @@ int main(int argc, char* argv[]) {
         else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
             try {
                 lobbies = std::stoi(argv[++i]);
-                if (lobbies < 1 || lobbies > 100) {
-                    std::cerr << "❌ Počet místností musí být 1-100" << std::endl;
+                if (lobbies < 1 || lobbies > LobbyManager::MAX_LOBBIES) {
+                    std::cerr << "❌ Počet místností musí být 1-" << LobbyManager::MAX_LOBBIES << std::endl;
                     return 1;
                 }
             } catch (...) {
@@ -96,6 +108,50 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
         }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            try {
+                ioThreads = std::stoi(argv[++i]);
+                if (ioThreads < 1 || ioThreads > 64) {
+                    std::cerr << "❌ Počet I/O vláken musí být 1-64" << std::endl;
+                    return 1;
+                }
+            } catch (...) {
+                std::cerr << "❌ Neplatný počet I/O vláken: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            try {
+                gameThreads = std::stoi(argv[++i]);
+                if (gameThreads < 1 || gameThreads > 64) {
+                    std::cerr << "❌ Počet herních vláken musí být 1-64" << std::endl;
+                    return 1;
+                }
+            } catch (...) {
+                std::cerr << "❌ Neplatný počet herních vláken: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            try {
+                adminPort = std::stoi(argv[++i]);
+                if (adminPort < 1024 || adminPort > 65535) {
+                    std::cerr << "❌ Admin port musí být v rozsahu 1024-65535" << std::endl;
+                    return 1;
+                }
+            } catch (...) {
+                std::cerr << "❌ Neplatný admin port: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) {
+            LogLevel level;
+            if (!Logger::parseLevel(argv[++i], level)) {
+                std::cerr << "❌ Neplatná úroveň logu: " << argv[i] << std::endl;
+                return 1;
+            }
+            Logger::setLevel(level);
+        }
         else if (strcmp(argv[i], "-h") == 0) {
             printUsage(argv[0]);
             return 0;
@@ -118,9 +174,14 @@ int main(int argc, char* argv[]) {
     std::cout << "📋 KONFIGURACE:\n";
     std::cout << "   IP adresa:      " << ip << "\n";
     std::cout << "   Port:           " << port << "\n";
-    std::cout << "   Místnosti:      " << lobbies << "\n";
+    std::cout << "   Místnosti:      podle potřeby (limit " << lobbies << ")\n";
     std::cout << "   Hráčů/místnost: " << players << "\n";
-    std::cout << "   Celkem slotů:   " << (lobbies * players) << "\n";
+    std::cout << "   Max. slotů:     " << (lobbies * players) << "\n";
+    std::cout << "   I/O vlákna:     " << ioThreads << "\n";
+    std::cout << "   Herní vlákna:   " << gameThreads << "\n";
+    if (adminPort > 0) {
+        std::cout << "   Admin rozhraní: 127.0.0.1:" << adminPort << "\n";
+    }
     std::cout << "\n";
 
     // Vysvětlení IP adresy
@@ -140,7 +201,7 @@ int main(int argc, char* argv[]) {
     std::cout << std::string(44, '=') << "\n\n";
 
     // Vytvoříme server s IP adresou
-    GameServer server(ip, port, players, lobbies);
+    GameServer server(ip, port, players, lobbies, ioThreads, gameThreads, adminPort);
     globalServer = &server;
 
     // Nastavíme signal handler pro Ctrl+C
@@ -151,9 +212,11 @@ int main(int argc, char* argv[]) {
         // Spustíme server (blocking call)
         server.start();
     } catch (const std::exception& e) {
-        std::cerr << "❌ Chyba serveru: " << e.what() << std::endl;
+        LOG_ERROR("❌ Chyba serveru: {}", e.what());
+        Logger::instance().shutdown();
         return 1;
     }
-    
+
+    Logger::instance().shutdown();
     return 0;
 }
\ No newline at end of file
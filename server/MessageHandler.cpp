@@ -2,25 +2,25 @@
 #include "MessageHandler.hpp"
 #include "GameManager.hpp"
 #include "Protocol.hpp"
-#include <iostream>
+#include "Logger.hpp"
 
 MessageHandler::MessageHandler(NetworkManager* networkManager, ClientManager* clientManager, GameManager* gameManager)
     : networkManager(networkManager),
       clientManager(clientManager),
       gameManager(gameManager) {
 
-    std::cout << "📨 MessageHandler inicializován" << std::endl;
+    LOG_INFO("📨 MessageHandler inicializován");
 }
 
 void MessageHandler::processClientMessage(ClientInfo* client, const Protocol::Message& msg) {
 
-    std::cout << "\n📨 Od hráče #" << client->playerNumber << " ";
-
     Protocol::MessageType msgType = msg.type;
-    std::vector<std::string> data = msg.fields;
 
-    std::cout << "🔄 Zpracovávám zprávu typu: " << static_cast<int>(msgType)
-              << " od hráče #" << client->playerNumber << std::endl;
+    // Vše, co zpracování zprávy pošle (STATE, CLIENT_DATA, RESULT, YOUR_TURN...),
+    // odejde každému příjemci jedním zápisem až po dokončení handleru
+    auto batch = networkManager->batch();
+
+    LOG_DEBUG("\n📨 Od hráče #{}: zpracovávám zprávu typu {}", client->playerNumber, static_cast<int>(msgType));
 
     // ===== TRICK =====
     if (msgType == Protocol::MessageType::TRICK) {
@@ -28,19 +28,19 @@ void MessageHandler::processClientMessage(ClientInfo* client, const Protocol::Me
     }
     // ===== CARD =====
     else if (msgType == Protocol::MessageType::CARD) {
-        handleCard(data.at(0));
+        handleCard(msg.fields.at(0));
     }
     // ===== BIDDING =====
     else if (msgType == Protocol::MessageType::BIDDING) {
-        handleBidding(data.at(0));
+        handleBidding(msg.fields.at(0));
     }
     // ===== RESET =====
     else if (msgType == Protocol::MessageType::RESET) {
-        handleReset(client, data.at(0));
+        handleReset(client, msg.fields.at(0));
     }
     // ===== PING =====
     else if (msgType == Protocol::MessageType::PING) {
-        networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::PONG, {});
+        networkManager->sendMessage(client, Protocol::MessageType::PONG, {});
         client->lastSeen = std::chrono::steady_clock::now();
     }
     // ===== DISCONNECT =====
@@ -54,10 +54,8 @@ void MessageHandler::processClientMessage(ClientInfo* client, const Protocol::Me
 
     // ===== UNKNOWN =====
     else {
-        std::cerr << "⚠ Neznámý typ zprávy: " << static_cast<int>(msgType) << std::endl;
-        sendError(client, Protocol::MessageType::DISCONNECT, "Neznámý typ zprávy: Odpojuji...\n");
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        clientManager->disconnectClient(client);
+        LOG_WARN("⚠ Neznámý typ zprávy: {}", static_cast<int>(msgType));
+        clientManager->kickClient(client, {"Neznámý typ zprávy: Odpojuji...\n"});
     }
 }
 
@@ -68,44 +66,41 @@ void MessageHandler::handleTrick(ClientInfo* client) {
     gameManager->handleTrick(client);
 }
 
-void MessageHandler::handleCard(const std::string& data) {
-    Card card = cardMapping(data);
+void MessageHandler::handleCard(std::string_view data) {
+    Card card = cardMapping(std::string(data));
     gameManager->handleCard(card);
 }
 
-void MessageHandler::handleBidding(std::string& label) {
+void MessageHandler::handleBidding(std::string_view data) {
+    std::string label(data);
     gameManager->handleBidding(label);
 
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-    gameManager->notifyActivePlayer();
+    // YOUR_TURN přijde s prodlevou, čtení od klienta ale pokračuje hned
+    gameManager->scheduleNotifyActivePlayer();
 }
 
-void MessageHandler::handleReset(ClientInfo* client, const std::string& data) {
-    std::cout << "🔄 Hráč #" << client->playerNumber << " žádá o reset" << std::endl;
+void MessageHandler::handleReset(ClientInfo* client, std::string_view data) {
+    LOG_INFO("🔄 Hráč #{} žádá o reset", client->playerNumber);
 
     if (data == "ANO") {
         clientManager->setauthorizeCount();
         clientManager->sendToPlayer(client->playerNumber, Protocol::MessageType::WAIT_LOBBY,
             {std::to_string(clientManager->getauthorizeCount())});
-        std::cout << "  -> WAIT_LOBBY odesláno hráči #" << client->playerNumber << std::endl;
+        LOG_INFO("  -> WAIT_LOBBY odesláno hráči #{}", client->playerNumber);
+
+        // Poslední potvrzení hned spustí novou hru
+        clientManager->notifyReadiness();
     } else {
         client->approved = false;
-        networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT, {});
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        clientManager->disconnectClient(client);
+        clientManager->kickClient(client, {});
     }
 }
 
 void MessageHandler::handleDisconnect(ClientInfo* client) {
-    std::cout << "👋 Hráč #" << client->playerNumber << " se odpojuje" << std::endl;
+    LOG_INFO("👋 Hráč #{} se odpojuje", client->playerNumber);
     clientManager->disconnectClient(client);
 }
 
 void MessageHandler::handleConnect(ClientInfo* client) {
-    std::cout << "📨 Přijato CONNECT od hráče #" << client->playerNumber << std::endl;
+    LOG_INFO("📨 Přijato CONNECT od hráče #{}", client->playerNumber);
 }
-
-void MessageHandler::sendError(ClientInfo* client, Protocol::MessageType msgType, const std::string& errorMessage) {
-    std::string errorData = errorMessage.empty() ? "Chyba zpracování požadavku" : errorMessage;
-    networkManager->sendMessage(client->socket, client->playerNumber, msgType, {errorData});
-}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MESSAGE_HANDLER_HPP
 
 #include <string>
+#include <string_view>
 #include "GameManager.hpp"
 
 class GameManager;
@@ -11,7 +12,7 @@ class MessageHandler {
 public:
     MessageHandler(NetworkManager* networkManager, ClientManager* clientManager, GameManager* gameManager);
 
-    // Zpracování zpráv
+    // Zpracování zpráv (běží ve strandu místnosti – zpráva je vlastnící kopie)
     void processClientMessage(ClientInfo* client, const Protocol::Message& msg);
 
 private:
@@ -21,14 +22,11 @@ private:
 
     // Jednotlivé handlery pro různé typy zpráv
     void handleTrick(ClientInfo* client);
-    void handleCard(const std::string&);
-    void handleBidding(std::string& data);
-    void handleReset(ClientInfo* client, const std::string& data);
+    void handleCard(std::string_view data);
+    void handleBidding(std::string_view data);
+    void handleReset(ClientInfo* client, std::string_view data);
     void handleDisconnect(ClientInfo* client);
     void handleConnect(ClientInfo* client);
-
-    // Pomocné funkce
-    void sendError(ClientInfo* client, Protocol::MessageType, const std::string& errorMessage);
 };
 
 #endif // MESSAGE_HANDLER_HPP
\ No newline at end of file
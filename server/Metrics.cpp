@@ -0,0 +1,214 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // Shard vlákna se přidělí při prvním zápisu a vlákno ho už nemění
+    std::atomic<size_t> nextShard{0};
+    thread_local size_t shardIndex = SIZE_MAX;
+
+    void storeMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+// ============================================================
+// HISTOGRAM
+// ============================================================
+size_t Metrics::Histogram::bucketFor(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    int msb = 63 - __builtin_clzll(value);
+    if (msb >= MAX_BITS) {
+        return BUCKETS - 1;
+    }
+
+    // Koše po mocninách dvou, v každé SUB_BUCKETS lineárních dílů podle bitů pod nejvyšším
+    int shift = msb - SUB_BITS;
+    return (static_cast<size_t>(shift + 1) << SUB_BITS) + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t Metrics::Histogram::bucketUpperBound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+
+    int shift = static_cast<int>(bucket >> SUB_BITS) - 1;
+    uint64_t mantissa = SUB_BUCKETS + (bucket & (SUB_BUCKETS - 1));
+    return ((mantissa + 1) << shift) - 1;
+}
+
+uint64_t Metrics::Histogram::percentile(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(count) + 0.5);
+    rank = std::clamp<uint64_t>(rank, 1, count);
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(bucket), max);
+        }
+    }
+    return max;
+}
+
+// ============================================================
+// ZÁPIS
+// ============================================================
+Metrics::Metrics() : shards(std::make_unique<Shard[]>(SHARDS)) {}
+
+Metrics::~Metrics() = default;
+
+Metrics::Shard& Metrics::localShard() {
+    if (shardIndex == SIZE_MAX) {
+        shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    }
+    return shards[shardIndex];
+}
+
+size_t Metrics::typeIndex(Protocol::MessageType type) {
+    auto index = static_cast<size_t>(type);
+    return index < MESSAGE_TYPES ? index : 0;
+}
+
+void Metrics::recordInbound(Protocol::MessageType type, size_t bytes) {
+    Shard& shard = localShard();
+    size_t index = typeIndex(type);
+    shard.messagesIn[index].fetch_add(1, std::memory_order_relaxed);
+    shard.bytesIn[index].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::recordOutbound(Protocol::MessageType type, size_t bytes) {
+    Shard& shard = localShard();
+    size_t index = typeIndex(type);
+    shard.messagesOut[index].fetch_add(1, std::memory_order_relaxed);
+    shard.bytesOut[index].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::recordValidationFailure(int result) {
+    if (result < 0 || static_cast<size_t>(result) >= VALIDATION_RESULTS) {
+        return;
+    }
+    localShard().validationFailures[result].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordHandlerLatency(Protocol::MessageType type, std::chrono::nanoseconds elapsed) {
+    auto value = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+    HistogramShard& histogram = localShard().handler[typeIndex(type)];
+
+    histogram.counts[Histogram::bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sum.fetch_add(value, std::memory_order_relaxed);
+    storeMax(histogram.max, value);
+}
+
+void Metrics::recordReconnect(bool success) {
+    Shard& shard = localShard();
+    (success ? shard.reconnects : shard.reconnectFailures).fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::setOccupancy(int lobbyCount, int occupied, int open) {
+    lobbies.store(lobbyCount, std::memory_order_relaxed);
+    occupiedSeats.store(occupied, std::memory_order_relaxed);
+    openSeats.store(open, std::memory_order_relaxed);
+}
+
+// ============================================================
+// ČTENÍ
+// ============================================================
+Metrics::Snapshot Metrics::snapshot() const {
+    Snapshot result;
+
+    for (size_t s = 0; s < SHARDS; s++) {
+        const Shard& shard = shards[s];
+
+        for (size_t type = 0; type < MESSAGE_TYPES; type++) {
+            MessageStats& stats = result.messages[type];
+            stats.in += shard.messagesIn[type].load(std::memory_order_relaxed);
+            stats.out += shard.messagesOut[type].load(std::memory_order_relaxed);
+            stats.bytesIn += shard.bytesIn[type].load(std::memory_order_relaxed);
+            stats.bytesOut += shard.bytesOut[type].load(std::memory_order_relaxed);
+
+            const HistogramShard& source = shard.handler[type];
+            Histogram& target = stats.handler;
+            if (source.count.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            for (size_t bucket = 0; bucket < Histogram::BUCKETS; bucket++) {
+                target.counts[bucket] += source.counts[bucket].load(std::memory_order_relaxed);
+            }
+            target.sum += source.sum.load(std::memory_order_relaxed);
+            target.max = std::max(target.max, source.max.load(std::memory_order_relaxed));
+        }
+
+        for (size_t reason = 0; reason < VALIDATION_RESULTS; reason++) {
+            result.validationFailures[reason] += shard.validationFailures[reason].load(std::memory_order_relaxed);
+        }
+        result.reconnects += shard.reconnects.load(std::memory_order_relaxed);
+        result.reconnectFailures += shard.reconnectFailures.load(std::memory_order_relaxed);
+    }
+
+    // Počet vzorků z košů – percentily pak sedí s koši i při souběžném zápisu
+    for (auto& stats : result.messages) {
+        stats.handler.count = 0;
+        for (uint64_t bucketCount : stats.handler.counts) {
+            stats.handler.count += bucketCount;
+        }
+    }
+
+    result.lobbies = lobbies.load(std::memory_order_relaxed);
+    result.occupiedSeats = occupiedSeats.load(std::memory_order_relaxed);
+    result.openSeats = openSeats.load(std::memory_order_relaxed);
+    return result;
+}
+
+std::string Metrics::getSummary() const {
+    Snapshot current = snapshot();
+
+    uint64_t in = 0, out = 0, bytesIn = 0, bytesOut = 0, invalid = 0;
+    for (const auto& stats : current.messages) {
+        in += stats.in;
+        out += stats.out;
+        bytesIn += stats.bytesIn;
+        bytesOut += stats.bytesOut;
+    }
+    for (uint64_t failures : current.validationFailures) {
+        invalid += failures;
+    }
+
+    std::string summary = "Zprávy: přijato " + std::to_string(in) + " (" + std::to_string(bytesIn) +
+                          " B), odesláno " + std::to_string(out) + " (" + std::to_string(bytesOut) +
+                          " B), nevalidní " + std::to_string(invalid) + ", reconnecty " +
+                          std::to_string(current.reconnects) + "/" +
+                          std::to_string(current.reconnects + current.reconnectFailures) + "\n";
+
+    // Typy zpráv, jejichž zpracování stojí nejvíc času celkem
+    std::vector<size_t> types;
+    for (size_t type = 0; type < MESSAGE_TYPES; type++) {
+        if (current.messages[type].handler.count > 0) {
+            types.push_back(type);
+        }
+    }
+    std::sort(types.begin(), types.end(), [&current](size_t a, size_t b) {
+        return current.messages[a].handler.sum > current.messages[b].handler.sum;
+    });
+
+    for (size_t i = 0; i < types.size() && i < 3; i++) {
+        const Histogram& handler = current.messages[types[i]].handler;
+        summary += "  " + std::string(Protocol::messageTypeName(static_cast<Protocol::MessageType>(types[i]))) +
+                   ": " + std::to_string(handler.count) + "x, celkem " + std::to_string(handler.sum / 1000) +
+                   " µs, p50 " + std::to_string(handler.percentile(50) / 1000) + " µs, p99 " +
+                   std::to_string(handler.percentile(99) / 1000) + " µs\n";
+    }
+    return summary;
+}
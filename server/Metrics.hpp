@@ -0,0 +1,107 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Protocol.hpp"
+
+// Metriky serveru – počty zpráv podle typu, přenesené bajty, odmítnuté zprávy,
+// reconnecty, obsazenost místností a latence zpracování zpráv.
+// Zápis jde do shardu vlákna (relaxed atomiky v samostatných cache lines),
+// takže vlákna reaktoru a herní vlákna se o žádný čítač nepřetahují.
+// Snímek shardy jen sečte – bez zámků a bez zastavení zapisujících vláken.
+class Metrics {
+public:
+    static constexpr size_t SHARDS = 16;             // Počet shardů (vlákna se rozdělí round-robin)
+    static constexpr size_t MESSAGE_TYPES = 22;      // Index = hodnota Protocol::MessageType (0 = neznámý)
+    static constexpr size_t VALIDATION_RESULTS = 9;  // Index = hodnota NetworkManager::ValidationResult
+
+    // Histogram s logaritmicko-lineárními koši (jako HDR histogram): každá mocnina
+    // dvou je rozdělená na SUB_BUCKETS dílů, relativní chyba je tak nejvýš 1/8
+    // v celém rozsahu od nanosekund po desítky sekund
+    struct Histogram {
+        static constexpr int SUB_BITS = 3;
+        static constexpr uint64_t SUB_BUCKETS = 1u << SUB_BITS;
+        static constexpr int MAX_BITS = 36;  // Hodnoty nad 2^36 ns (~69 s) padají do posledního koše
+        static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+        std::array<uint64_t, BUCKETS> counts{};
+        uint64_t count = 0;  // Počet vzorků
+        uint64_t sum = 0;    // Součet hodnot (ns)
+        uint64_t max = 0;    // Největší hodnota (ns)
+
+        uint64_t percentile(double p) const; // Horní mez koše, do kterého spadá p-tý percentil (ns)
+
+        static size_t bucketFor(uint64_t value);        // Koš pro hodnotu
+        static uint64_t bucketUpperBound(size_t bucket); // Největší hodnota koše
+    };
+
+    // Souhrn jednoho typu zprávy
+    struct MessageStats {
+        uint64_t in = 0;        // Přijaté zprávy
+        uint64_t out = 0;       // Odeslané zprávy
+        uint64_t bytesIn = 0;   // Přijaté bajty
+        uint64_t bytesOut = 0;  // Odeslané bajty
+        Histogram handler;      // Latence zpracování ve strandu (ns)
+    };
+
+    struct Snapshot {
+        std::array<MessageStats, MESSAGE_TYPES> messages;
+        std::array<uint64_t, VALIDATION_RESULTS> validationFailures{};
+        uint64_t reconnects = 0;        // Úspěšné reconnecty
+        uint64_t reconnectFailures = 0; // Odmítnuté reconnecty
+        int64_t lobbies = 0;            // Vytvořené místnosti
+        int64_t occupiedSeats = 0;      // Obsazená místa
+        int64_t openSeats = 0;          // Volná místa
+    };
+
+    Metrics();
+    ~Metrics();
+
+    // ===== Zápis (libovolné vlákno) =====
+    void recordInbound(Protocol::MessageType type, size_t bytes);
+    void recordOutbound(Protocol::MessageType type, size_t bytes);
+    void recordValidationFailure(int result);
+    void recordHandlerLatency(Protocol::MessageType type, std::chrono::nanoseconds elapsed);
+    void recordReconnect(bool success);
+    void setOccupancy(int lobbies, int occupiedSeats, int openSeats);
+
+    // ===== Čtení =====
+    Snapshot snapshot() const;  // Součet všech shardů (lock-free, jednotlivé čítače nejsou vzájemně synchronizované)
+    std::string getSummary() const; // Krátký souhrn pro výpis stavu serveru
+
+private:
+    struct HistogramShard {
+        std::array<std::atomic<uint64_t>, Histogram::BUCKETS> counts{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> max{0};
+    };
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, MESSAGE_TYPES> messagesIn{};
+        std::array<std::atomic<uint64_t>, MESSAGE_TYPES> messagesOut{};
+        std::array<std::atomic<uint64_t>, MESSAGE_TYPES> bytesIn{};
+        std::array<std::atomic<uint64_t>, MESSAGE_TYPES> bytesOut{};
+        std::array<std::atomic<uint64_t>, VALIDATION_RESULTS> validationFailures{};
+        std::atomic<uint64_t> reconnects{0};
+        std::atomic<uint64_t> reconnectFailures{0};
+        std::array<HistogramShard, MESSAGE_TYPES> handler;
+    };
+
+    std::unique_ptr<Shard[]> shards;      // Shardy čítačů (na haldě – jeden má desítky kB)
+    std::atomic<int64_t> lobbies{0};      // Gauge: vytvořené místnosti
+    std::atomic<int64_t> occupiedSeats{0}; // Gauge: obsazená místa
+    std::atomic<int64_t> openSeats{0};    // Gauge: volná místa
+
+    Shard& localShard(); // Shard volajícího vlákna
+    static size_t typeIndex(Protocol::MessageType type); // Index typu (neznámé typy -> 0)
+};
+
+#endif // METRICS_HPP
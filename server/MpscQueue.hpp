@@ -0,0 +1,105 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Omezená lock-free fronta pro více producentů a jednoho konzumenta.
+// Kruhový buffer se sekvenčním číslem v každé buňce: producent si buňku
+// zabere posunem tail (CAS) a zveřejní ji zápisem sekvence, konzument čte
+// jen zveřejněné buňky. Vložení ani vyjmutí nikdy neblokuje – plná fronta
+// vložení odmítne a volající rozhodne, co dál (backpressure).
+template <typename T>
+class MpscQueue {
+public:
+    // Kapacita se zaokrouhlí nahoru na mocninu dvou
+    explicit MpscQueue(size_t requestedCapacity) : mask(roundUp(requestedCapacity) - 1), head(0), tail(0) {
+        cells = std::make_unique<Cell[]>(mask + 1);
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Libovolné vlákno – false, pokud je fronta plná
+    bool tryPush(T&& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0) {
+                // Buňka je volná – zkusíme ji zabrat
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Konzument buňku ještě neuvolnil – fronta je plná
+            } else {
+                position = tail.load(std::memory_order_relaxed);  // Předběhl nás jiný producent
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Jen konzument – false, pokud na začátku fronty není zveřejněná položka
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[position & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(position + mask + 1, std::memory_order_release);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Jen konzument – je na začátku fronty zveřejněná položka
+    bool hasReady() const {
+        size_t position = head.load(std::memory_order_relaxed);
+        return cells[position & mask].sequence.load(std::memory_order_acquire) == position + 1;
+    }
+
+    // Přibližný počet položek (zabrané i zveřejněné) – pro metriky
+    size_t size() const {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_relaxed);
+        return t >= h ? t - h : 0;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence; // position + 1 = zveřejněno, position + kapacita = volno
+        T value;
+    };
+
+    static size_t roundUp(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;  // Konzument
+    alignas(64) std::atomic<size_t> tail;  // Producenti
+};
+
+#endif // MPSC_QUEUE_HPP
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
@@ -12,20 +11,26 @@
 
 #include "NetworkManager.hpp"
 #include "ClientManager.hpp"
+#include "Metrics.hpp"
+#include "TimerWheel.hpp"
+#include "Logger.hpp"
 
 #define QUEUE_LENGTH 10
 
+static_assert(OutboundFrame::HEADER_CAPACITY >= Protocol::MAX_HEADER_LENGTH,
+              "Hlavička odchozího rámce se nevejde do OutboundFrame");
+
 // 🆕 Konstruktor s IP adresou
-NetworkManager::NetworkManager(const std::string& ip, int port)
-    : bindIP(ip), serverSocket(-1), port(port), packetID(1) {
+NetworkManager::NetworkManager(const std::string& ip, int port, TimerWheel* timerWheel, Metrics* metrics)
+    : bindIP(ip), serverSocket(-1), port(port), timerWheel(timerWheel), metrics(metrics) {
 
-    packets.resize(MAXIMUM_PACKET_SIZE, {});
-    std::cout << "🔧 NetworkManager inicializován" << std::endl;
-    std::cout << "   - Bind IP: " << bindIP << std::endl;
-    std::cout << "   - Port: " << port << std::endl;
+    LOG_INFO("🔧 NetworkManager inicializován");
+    LOG_INFO("   - Bind IP: {}", bindIP);
+    LOG_INFO("   - Port: {}", port);
 }
 
 NetworkManager::~NetworkManager() {
+    stopReactor();
     closeServerSocket();
 }
 
@@ -33,31 +38,44 @@ NetworkManager::~NetworkManager() {
 #include <cctype>
 #include <regex>
 
-bool NetworkManager::isValidMessageString(const std::string& data) {
+std::string_view NetworkManager::validationResultName(ValidationResult result) {
+    switch (result) {
+        case ValidationResult::VALID: return "VALID";
+        case ValidationResult::INVALID_CLIENT_ID: return "INVALID_CLIENT_ID";
+        case ValidationResult::INVALID_PACKET_ID: return "INVALID_PACKET_ID";
+        case ValidationResult::INVALID_MESSAGE_TYPE: return "INVALID_MESSAGE_TYPE";
+        case ValidationResult::INVALID_PACKET_SEQUENCE: return "INVALID_PACKET_SEQUENCE";
+        case ValidationResult::MALFORMED_DATA: return "MALFORMED_DATA";
+        case ValidationResult::INVALID_FIELD_COUNT: return "INVALID_FIELD_COUNT";
+        case ValidationResult::INVALID_CHARACTERS: return "INVALID_CHARACTERS";
+        case ValidationResult::MESSAGE_TOO_LARGE: return "MESSAGE_TOO_LARGE";
+    }
+    return "UNKNOWN";
+}
+
+bool NetworkManager::isValidMessageString(std::string_view data) {
     // === 1. Kontrola prázdné zprávy ===
     if (data.empty()) {
-        std::cerr << "❌ [VALIDATION] Prázdná zpráva" << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Prázdná zpráva");
         return false;
     }
 
     // === 2. Kontrola délky ===
     if (data.length() > Protocol::MAX_MESSAGE_SIZE) {
-        std::cerr << "❌ [VALIDATION] Zpráva příliš dlouhá: "
-                  << data.length() << " > " << Protocol::MAX_MESSAGE_SIZE << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Zpráva příliš dlouhá: {} > {}", data.length(), Protocol::MAX_MESSAGE_SIZE);
         return false;
     }
 
     // === 3. Kontrola terminátoru ===
     if (data.back() != Protocol::TERMINATOR) {
-        std::cerr << "❌ [VALIDATION] Chybí terminátor \\n" << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Chybí terminátor \\n");
         return false;
     }
 
     // === 4. Počet delimiterů (minimálně 3: SIZE|PACKET|CLIENT|TYPE) ===
     int delimiterCount = std::count(data.begin(), data.end(), Protocol::DELIMITER);
     if (delimiterCount < 2) {
-        std::cerr << "❌ [VALIDATION] Nedostatek delimiterů: "
-                  << delimiterCount << " < 2" << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Nedostatek delimiterů: {} < 2", delimiterCount);
         return false;
     }
 
@@ -67,42 +85,41 @@ bool NetworkManager::isValidMessageString(const std::string& data) {
 
         // Null byte
         if (c == 0) {
-            std::cerr << "❌ [VALIDATION] Null byte na pozici " << i << std::endl;
+            LOG_ERROR("❌ [VALIDATION] Null byte na pozici {}", i);
             return false;
         }
 
         // Kontrolní znaky (kromě \n a \r)
         if (c < 32 && c != '\n' && c != '\r') {
-            std::cerr << "❌ [VALIDATION] Neplatný kontrolní znak: "
-                      << static_cast<int>(c) << " na pozici " << i << std::endl;
+            LOG_ERROR("❌ [VALIDATION] Neplatný kontrolní znak: {} na pozici {}", static_cast<int>(c), i);
             return false;
         }
     }
 
     // === 6. Kontrola parsovatelnosti první části (SIZE) ===
     size_t firstDelim = data.find(Protocol::DELIMITER);
-    if (firstDelim == std::string::npos) {
+    if (firstDelim == std::string_view::npos) {
         return false;
     }
 
-    std::string sizeStr = data.substr(0, firstDelim);
+    std::string_view sizeStr = data.substr(0, firstDelim);
 
     // SIZE musí být číslo
     if (sizeStr.empty() || !std::all_of(sizeStr.begin(), sizeStr.end(), ::isdigit)) {
-        std::cerr << "❌ [VALIDATION] SIZE není číslo: '" << sizeStr << "'" << std::endl;
+        LOG_ERROR("❌ [VALIDATION] SIZE není číslo: '{}'", sizeStr);
         return false;
     }
 
     // === 7. Kontrola podezřelých vzorů (opakující se znaky = spam) ===
     if (containsSuspiciousPatterns(data)) {
-        std::cerr << "❌ [VALIDATION] Detekován podezřelý vzor (spam)" << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Detekován podezřelý vzor (spam)");
         return false;
     }
 
     return true;
 }
 
-bool NetworkManager::containsSuspiciousPatterns(const std::string& str) {
+bool NetworkManager::containsSuspiciousPatterns(std::string_view str) {
     // Kontrola opakujících se znaků (100+ stejných znaků za sebou = spam)
     int consecutiveCount = 1;
     char lastChar = 0;
@@ -111,8 +128,7 @@ bool NetworkManager::containsSuspiciousPatterns(const std::string& str) {
         if (c == lastChar) {
             consecutiveCount++;
             if (consecutiveCount > 100) {
-                std::cout << "⚠️ [VALIDATION] Detekováno " << consecutiveCount
-                          << " opakujících se znaků" << std::endl;
+                LOG_WARN("⚠️ [VALIDATION] Detekováno {} opakujících se znaků", consecutiveCount);
                 return true;
             }
         } else {
@@ -124,16 +140,18 @@ bool NetworkManager::containsSuspiciousPatterns(const std::string& str) {
     return false;
 }
 
-int NetworkManager::Validation(const Protocol::Message & msg, const int clientNumber, const int requiredPlayers) {
+int NetworkManager::Validation(const Protocol::MessageView & msg, const int clientNumber, const int requiredPlayers,
+                               const uint32_t lastSentID) {
     auto validationResult = validateMessage(
         msg,
         clientNumber,
-        requiredPlayers
+        requiredPlayers,
+        lastSentID
     );
 
     if (validationResult != ValidationResult::VALID) {
-        std::cerr << "❌ Hráč #" << clientNumber << " poslal nevalidní zprávu (kód: "
-            << static_cast<int>(validationResult) << "), odpojuji" << std::endl;
+        metrics->recordValidationFailure(static_cast<int>(validationResult));
+        LOG_ERROR("❌ Hráč #{} poslal nevalidní zprávu (kód: {}), odpojuji", clientNumber, static_cast<int>(validationResult));
         return 0;
     }
 
@@ -141,30 +159,29 @@ int NetworkManager::Validation(const Protocol::Message & msg, const int clientNu
 }
 
 NetworkManager::ValidationResult NetworkManager::validateMessage(
-    const Protocol::Message &msg,
+    const Protocol::MessageView &msg,
     int clientNumber,
-    int requiredPlayers) {
+    int requiredPlayers,
+    uint32_t lastSentID) {
 
-    std::cout << "🔍 [VALIDATION] Validuji zprávu od klienta #" << clientNumber << std::endl;
-    std::cout << "   - PacketID: " << static_cast<int>(msg.packetID) << std::endl;
-    std::cout << "   - ClientID: " << static_cast<int>(msg.clientID) << std::endl;
-    std::cout << "   - Type: " << static_cast<int>(msg.type) << std::endl;
-    std::cout << "   - Fields: " << msg.fields.size() << std::endl;
+    LOG_DEBUG("🔍 [VALIDATION] Validuji zprávu od klienta #{}", clientNumber);
+    LOG_DEBUG("   - PacketID: {}", msg.packetID);
+    LOG_DEBUG("   - ClientID: {}", static_cast<int>(msg.clientID));
+    LOG_DEBUG("   - Type: {}", static_cast<int>(msg.type));
+    LOG_DEBUG("   - Fields: {}", msg.fieldCount);
 
     // === 1. KONTROLA CLIENT ID ===
     // ClientID musí odpovídat očekávanému číslu klienta
     if (msg.type != Protocol::MessageType::RECONNECT) {
         if (msg.clientID != clientNumber) {
-            std::cerr << "❌ [VALIDATION] ClientID nesouhlasí: "
-                      << static_cast<int>(msg.clientID) << " != " << clientNumber << std::endl;
+            LOG_ERROR("❌ [VALIDATION] ClientID nesouhlasí: {} != {}", static_cast<int>(msg.clientID), clientNumber);
             return ValidationResult::INVALID_CLIENT_ID;
         }
     }
 
     // ClientID musí být v platném rozsahu
     if (msg.clientID >= requiredPlayers) {
-        std::cerr << "❌ [VALIDATION] ClientID mimo rozsah: "
-                  << static_cast<int>(msg.clientID) << " >= " << requiredPlayers << std::endl;
+        LOG_ERROR("❌ [VALIDATION] ClientID mimo rozsah: {} >= {}", static_cast<int>(msg.clientID), requiredPlayers);
         return ValidationResult::INVALID_CLIENT_ID;
     }
 
@@ -172,65 +189,53 @@ NetworkManager::ValidationResult NetworkManager::validateMessage(
     // Type musí být validní (1-20)
     int typeValue = static_cast<int>(msg.type);
     if (typeValue < 1 || typeValue > 20) {
-        std::cerr << "❌ [VALIDATION] Neplatný typ zprávy: " << typeValue << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Neplatný typ zprávy: {}", typeValue);
         return ValidationResult::INVALID_MESSAGE_TYPE;
     }
 
     // === 3. KONTROLA PACKET ID SEKVENCE ===
-    // PacketID by měl postupovat logicky (s tolerancí pro wraparound)
-    if (clientNumber >= 0) {
-        int lastPacketID = findLatestPacketID(clientNumber);
-
-        if (lastPacketID != -1) {
-            // Spočítej očekávané ID (s wraparoundem)
-            int expectedID = (lastPacketID + 1) % MAXIMUM_PACKET_SIZE;
-
-            // Toleruj malé rozdíly (kvůli retransmisi nebo ztrátě packetu)
-            int diff = std::abs(msg.packetID - expectedID);
-
-            // Pokud je rozdíl větší než 10, je to podezřelé
-            if (diff > 10 && diff < (MAXIMUM_PACKET_SIZE - 10)) {
-                std::cerr << "⚠️ [VALIDATION] Podezřelá sekvence packetID: "
-                          << static_cast<int>(msg.packetID) << " (očekáváno ~"
-                          << expectedID << ")" << std::endl;
-            }
+    // Klient v PacketID potvrzuje poslední přijatý paket z řady tohoto spojení.
+    // Řada je souvislá, takže potvrzení nesmí předběhnout poslední odeslané ID
+    // a nemělo by zaostávat víc, než kolik paketů ještě může být na cestě.
+    if (clientNumber >= 0 && msg.type != Protocol::MessageType::RECONNECT) {
+        uint32_t behind = lastSentID - msg.packetID;  // Rozdíl modulo 2^32
+
+        if (behind > PacketHistory::CAPACITY) {
+            LOG_WARN("⚠️ [VALIDATION] Podezřelá sekvence packetID: {} (poslední odeslané {})", msg.packetID, lastSentID);
         }
     }
 
     // === 5. KONTROLA OBSAHU FIELDS ===
-    for (size_t i = 0; i < msg.fields.size(); i++) {
-        const std::string& field = msg.fields[i];
+    for (size_t i = 0; i < msg.fieldCount; i++) {
+        std::string_view field = msg.fields[i];
 
         // Field nesmí být příliš dlouhý
         if (field.length() > 1000) {
-            std::cerr << "❌ [VALIDATION] Field " << i << " je příliš dlouhý: "
-                      << field.length() << " znaků" << std::endl;
+            LOG_ERROR("❌ [VALIDATION] Field {} je příliš dlouhý: {} znaků", i, field.length());
             return ValidationResult::MALFORMED_DATA;
         }
 
         // Field nesmí obsahovat null bytes
-        if (field.find('\0') != std::string::npos) {
-            std::cerr << "❌ [VALIDATION] Field " << i << " obsahuje null byte" << std::endl;
+        if (field.find('\0') != std::string_view::npos) {
+            LOG_ERROR("❌ [VALIDATION] Field {} obsahuje null byte", i);
             return ValidationResult::INVALID_CHARACTERS;
         }
 
         // Field nesmí obsahovat delimiter nebo terminator
-        if (field.find(Protocol::DELIMITER) != std::string::npos ||
-            field.find(Protocol::TERMINATOR) != std::string::npos) {
-            std::cerr << "❌ [VALIDATION] Field " << i
-                      << " obsahuje zakázané znaky (| nebo \\n)" << std::endl;
+        if (field.find(Protocol::DELIMITER) != std::string_view::npos ||
+            field.find(Protocol::TERMINATOR) != std::string_view::npos) {
+            LOG_ERROR("❌ [VALIDATION] Field {} obsahuje zakázané znaky (| nebo \\n)", i);
             return ValidationResult::INVALID_CHARACTERS;
         }
     }
 
     // === 6. KONTROLA CELKOVÉ VELIKOSTI ===
     if (msg.size > Protocol::MAX_MESSAGE_SIZE) {
-        std::cerr << "❌ [VALIDATION] Zpráva příliš velká: "
-                  << msg.size << " > " << Protocol::MAX_MESSAGE_SIZE << std::endl;
+        LOG_ERROR("❌ [VALIDATION] Zpráva příliš velká: {} > {}", msg.size, Protocol::MAX_MESSAGE_SIZE);
         return ValidationResult::MESSAGE_TOO_LARGE;
     }
 
-    std::cout << "✅ [VALIDATION] Zpráva validní" << std::endl;
+    LOG_DEBUG("✅ [VALIDATION] Zpráva validní");
     return ValidationResult::VALID;
 }
 
@@ -240,7 +245,7 @@ std::vector<std::string> NetworkManager::getLocalIPAddresses() {
     struct ifaddrs* ifa = nullptr;
 
     if (getifaddrs(&ifAddrStruct) == -1) {
-        std::cerr << "Chyba při získávání IP adres" << std::endl;
+        LOG_ERROR("Chyba při získávání IP adres");
         return addresses;
     }
 
@@ -257,8 +262,7 @@ std::vector<std::string> NetworkManager::getLocalIPAddresses() {
             std::string addr = addressBuffer;
             if (addr != "127.0.0.1") {
                 addresses.push_back(addr);
-                std::cout << "🌐 Rozhraní: " << ifa->ifa_name
-                          << " -> IP: " << addr << std::endl;
+                LOG_INFO("🌐 Rozhraní: {} -> IP: {}", ifa->ifa_name, addr);
             }
         }
     }
@@ -271,18 +275,18 @@ std::vector<std::string> NetworkManager::getLocalIPAddresses() {
 }
 
 bool NetworkManager::initializeSocket() {
-    std::cout << "🔌 Inicializuji socket..." << std::endl;
+    LOG_INFO("🔌 Inicializuji socket...");
 
     serverSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (serverSocket < 0) {
-        std::cerr << "❌ Nepodařilo se vytvořit socket" << std::endl;
+        LOG_ERROR("❌ Nepodařilo se vytvořit socket");
         return false;
     }
 
     // Nastavení SO_REUSEADDR
     int opt = 1;
     if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        std::cerr << "⚠️  Varování: Nepodařilo se nastavit SO_REUSEADDR" << std::endl;
+        LOG_WARN("⚠️  Varování: Nepodařilo se nastavit SO_REUSEADDR");
     }
 
     sockaddr_in serverAddress{};
@@ -291,204 +295,275 @@ bool NetworkManager::initializeSocket() {
 
     // 🆕 Použití specifikované IP místo INADDR_ANY
     if (inet_pton(AF_INET, bindIP.c_str(), &serverAddress.sin_addr) <= 0) {
-        std::cerr << "❌ Neplatná IP adresa: " << bindIP << std::endl;
+        LOG_ERROR("❌ Neplatná IP adresa: {}", bindIP);
         close(serverSocket);
         return false;
     }
 
-    std::cout << "  -> Binding na " << bindIP << ":" << port << std::endl;
+    LOG_INFO("  -> Binding na {}:{}", bindIP, port);
 
     if (bind(serverSocket, (sockaddr*)&serverAddress, sizeof(serverAddress)) < 0) {
-        std::cerr << "❌ Bind selhal (možná je port " << port << " již používán)" << std::endl;
+        LOG_ERROR("❌ Bind selhal (možná je port {} již používán)", port);
         close(serverSocket);
         return false;
     }
 
     if (listen(serverSocket, 10) < 0) {
-        std::cerr << "❌ Listen selhal" << std::endl;
+        LOG_ERROR("❌ Listen selhal");
         close(serverSocket);
         return false;
     }
 
-    std::cout << "✅ Socket úspěšně inicializován na " << bindIP << ":" << port << std::endl;
+    LOG_INFO("✅ Socket úspěšně inicializován na {}:{}", bindIP, port);
     return true;
 }
 
 void NetworkManager::closeServerSocket() {
     if (serverSocket >= 0) {
-        std::cout << "🔌 Zavírám hlavní socket..." << std::endl;
+        LOG_INFO("🔌 Zavírám hlavní socket...");
         shutdown(serverSocket, SHUT_RDWR);
         close(serverSocket);
         serverSocket = -1;
     }
 }
 
-std::string NetworkManager::findPacketByID(int clientNumber, int packetID) {
-    // Kontrola rozsahu
-    if (packetID < 0 || packetID >= MAXIMUM_PACKET_SIZE) {
-        return {};
-    }
-
-    // Získáme packet na dané pozici
-    const auto& packet = packets[packetID];
-    Protocol::Message msg = Protocol::deserialize(packet);
+size_t NetworkManager::retransmit(ClientInfo* client, uint32_t lastReceivedID, bool& truncated) {
+    // Pod zámkem řady – nové pakety se nemohou zařadit mezi znovuposílané
+    auto lock = client->history.lock();
+    std::vector<OutboundFrame> frames = client->history.framesAfter(lastReceivedID, truncated);
 
-    // Kontrola zda packet existuje a patří správnému klientovi
-    if (packet.empty()) {
-        return {};
+    // Pakety odchází beze změny (se svými původními ID)
+    for (auto& frame : frames) {
+        LOG_DEBUG("   📤 Znovu posílám: {}{}", frame.header(), (frame.payload ? *frame.payload : ""));
+        if (!deliver(client->socket, frame)) {
+            break;
+        }
     }
 
-    int packetClientID = msg.clientID;
-    if (packetClientID == clientNumber) {
-        return packet;
-    }
+    return frames.size();
+}
 
-    return {};
+bool NetworkManager::sendMessage(ClientInfo* client,
+                                Protocol::MessageType msgType,
+                                std::vector<std::string> msg) {
+    return sendPayload(client, msgType, Protocol::serializePayload(msg));
 }
 
-int NetworkManager::findLatestPacketID(int clientNumber) {
-    int latestID = -1;
+bool NetworkManager::sendPayload(ClientInfo* client,
+                                 Protocol::MessageType msgType,
+                                 const Protocol::Payload& payload) {
+    thread_local std::string headerBuffer;
 
-    // Procházíme odzadu od aktuálního packetID
-    int currentID = (packetID - 1 + MAXIMUM_PACKET_SIZE) % MAXIMUM_PACKET_SIZE;
+    // Přidělení ID, uložení do historie a zařazení do fronty proběhne atomicky
+    auto lock = client->history.lock();
 
-    for (int i = 0; i < MAXIMUM_PACKET_SIZE; i++) {
-        const auto& packet = packets[currentID];
+    uint32_t packetID = client->history.nextID();
 
-        Protocol::Message msg = Protocol::deserialize(packet);
-        if (!packet.empty()) {
-            int packetClientID = msg.clientID;
-            if (packetClientID == clientNumber) {
-                latestID = msg.packetID;
-                break;
-            }
-        }
+    // Pro každého příjemce se serializuje jen hlavička (do rámce, bez alokace), data zůstávají sdílená
+    OutboundFrame frame{
+        Protocol::serializeHeader(packetID, static_cast<uint8_t>(client->playerNumber),
+                                  msgType, payload->size(), headerBuffer),
+        payload
+    };
 
-        currentID = (currentID - 1 + MAXIMUM_PACKET_SIZE) % MAXIMUM_PACKET_SIZE;
-    }
+    // Uložíme do historie klienta (pro reconnect)
+    client->history.store(frame);
+    metrics->recordOutbound(msgType, frame.size());
+
+    LOG_DEBUG("📤 Posílám packet ID:{} klientovi #{} (type: {})", packetID, client->playerNumber, static_cast<int>(msgType));
+    LOG_DEBUG("   Data: {}{}", frame.header(), *payload);
 
-    return latestID;
+    return deliver(client->socket, frame);
 }
 
 bool NetworkManager::sendMessage(int socket, int clientNumber,
                                 Protocol::MessageType msgType,
                                 std::vector<std::string> msg) {
-    // Vytvoříme zprávu
-    Protocol::Message message = Protocol::createMessage(
-        static_cast<uint8_t>(packetID),
-        static_cast<uint8_t>(clientNumber),
-        msgType,
-        msg
-    );
+    thread_local std::string headerBuffer;
+
+    // Klient bez ClientInfo (např. odmítnutí při plném serveru) nemá vlastní řadu ani historii – packet ID 0
+    Protocol::Payload payload = Protocol::serializePayload(msg);
+    OutboundFrame frame{
+        Protocol::serializeHeader(0, static_cast<uint8_t>(clientNumber), msgType, payload->size(), headerBuffer),
+        payload
+    };
+    metrics->recordOutbound(msgType, frame.size());
 
-    // Serializujeme do textového formátu
-    std::string textData = Protocol::serialize(message);
+    LOG_DEBUG("📤 Posílám packet ID:0 klientovi #{} (type: {})", clientNumber, static_cast<int>(msgType));
+    LOG_DEBUG("   Data: {}{}", frame.header(), *payload);
+
+    return deliver(socket, frame);
+}
 
-    // Uložíme do historie (pro reconnect)
-    if (clientNumber != -1) {
-        packets[packetID] = textData;  // 🆕 Uložíme jako string
+bool NetworkManager::deliver(int socket, OutboundFrame& frame) {
+    // Zařadíme do odchozí fronty spojení – nikdy neblokuje
+    if (reactor) {
+        switch (reactor->queueFrame(socket, frame)) {
+            case Reactor::QueueResult::QUEUED:
+                return true;
+            case Reactor::QueueResult::DROPPED:
+                LOG_ERROR("❌ Send selhal, socket mrtvý");
+                return false;
+            case Reactor::QueueResult::UNKNOWN_SOCKET:
+                break;
+        }
     }
 
-    std::cout << "📤 Posílám packet ID:" << packetID
-              << " klientovi #" << clientNumber
-              << " (type: " << static_cast<int>(message.type) << ")" << std::endl;
-    std::cout << "   Data: " << textData << std::endl;
+    // Socket ještě není v reaktoru (např. odmítnutí při plném serveru) – pošleme přímo
+    return sendAll(socket, frame.header()) && (!frame.payload || sendAll(socket, *frame.payload));
+}
 
-    // Inkrementace ID
-    packetID = (packetID + 1) % MAXIMUM_PACKET_SIZE;
+bool NetworkManager::sendAll(int socket, std::string_view data) {
+    size_t total = 0;
 
-    // Odeslání textových dat
-    ssize_t sent = send(socket, textData.c_str(), textData.length(), MSG_NOSIGNAL);
+    while (total < data.length()) {
+        ssize_t sent = send(socket, data.data() + total, data.length() - total, MSG_NOSIGNAL);
 
-    if (sent <= 0) {
-        std::cerr << "❌ Send selhal, socket mrtvý" << std::endl;
-        return false;
-    }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
 
-    if (sent != static_cast<ssize_t>(textData.length())) {
-        std::cerr << "❌ Neúplné odeslání packetu" << std::endl;
-        return false;
+        if (sent <= 0) {
+            LOG_ERROR("❌ Send selhal, socket mrtvý");
+            return false;
+        }
+
+        total += static_cast<size_t>(sent);
     }
 
     return true;
 }
 
-static bool readUntilNewline(int socket, std::string& output) {
-    output.clear();
-    char buffer[1];
+NetworkManager::ReadResult NetworkManager::receiveMessage(int socket, FrameBuffer& buffer, std::string_view& frame) {
+
+    // Nejdřív vydáme rámce, které už v bufferu jsou – recv jen když žádný celý není
+    while (!buffer.nextFrame(frame)) {
+        // Ochrana proti příliš dlouhým zprávám
+        if (buffer.isOverflowed()) {
+            LOG_ERROR("❌ Zpráva příliš dlouhá");
+            return ReadResult::CLOSED;
+        }
+
+        // Poslední čtení socket vyprázdnilo – další recv by jen vrátil EAGAIN
+        if (buffer.takeDrained()) {
+            return ReadResult::WOULD_BLOCK;
+        }
 
-    while (true) {
-        ssize_t r = recv(socket, buffer, 1, 0);
+        ssize_t r = buffer.fill(socket);
 
         // 🔴 Detekce odpojení
         if (r == 0) {
-            std::cout << "🔌 Socket " << socket << " byl zavřen" << std::endl;
-            return false;
+            LOG_INFO("🔌 Socket {} byl zavřen", socket);
+            LOG_INFO("🔌 receiveMessage: Selhalo čtení zprávy");
+            return ReadResult::CLOSED;
         }
 
         if (r < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                std::cout << "⏱️ Socket " << socket << " timeout" << std::endl;
-            } else {
-                std::cerr << "❌ Socket " << socket << " chyba: "
-                          << strerror(errno) << std::endl;
+                return ReadResult::WOULD_BLOCK;
             }
-            return false;
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("❌ Socket {} chyba: {}", socket, strerror(errno));
+            LOG_INFO("🔌 receiveMessage: Selhalo čtení zprávy");
+            return ReadResult::CLOSED;
         }
+    }
 
-        // Přidáme znak
-        output += buffer[0];
+    LOG_DEBUG("✅ Přijata zpráva: {}", frame);
+    return ReadResult::FRAME;
+}
 
-        // Pokud jsme našli \n, hotovo
-        if (buffer[0] == Protocol::TERMINATOR) {
-            return true;
-        }
+void NetworkManager::closeSocket(int socket) {
+    if (socket < 0) {
+        return;
+    }
 
-        // Ochrana proti příliš dlouhým zprávám
-        if (output.length() > Protocol::MAX_MESSAGE_SIZE) {
-            std::cerr << "❌ Zpráva příliš dlouhá" << std::endl;
-            return false;
-        }
+    // Socket v reaktoru dopošle frontu a uzavře se, až ho žádné vlákno nepoužívá
+    if (reactor && reactor->removeConnection(socket)) {
+        return;
+    }
+
+    shutdown(socket, SHUT_RDWR);
+    close(socket);
+}
+
+void NetworkManager::closeConnection(int socket, uint32_t generation) {
+    if (reactor) {
+        reactor->removeConnection(socket, generation);
     }
 }
 
-std::string NetworkManager::receiveMessage(int socket) {
-    std::string data;
+void NetworkManager::closeSocketAfter(int socket, std::chrono::milliseconds grace) {
+    if (socket < 0) {
+        return;
+    }
+
+    // Socket v reaktoru: po odeslání fronty FIN, dočtení dat a zavření po lhůtě
+    uint32_t generation = 0;
+    if (reactor && reactor->beginClose(socket, generation)) {
+        timerWheel->schedule(grace, [this, socket, generation](TimerWheel::TimerId) {
+            reactor->removeConnection(socket, generation);
+        });
+        return;
+    }
 
-    if (!readUntilNewline(socket, data)) {
-        std::cout << "🔌 receiveMessage: Selhalo čtení zprávy" << std::endl;
-        return "";
+    // Socket mimo reaktor (odmítnutí při plném serveru) – data už odešla přes sendAll
+    shutdown(socket, SHUT_WR);
+    timerWheel->schedule(grace, [socket](TimerWheel::TimerId) {
+        close(socket);
+    });
+}
+
+// ============================================================
+// REAKTOR
+// ============================================================
+bool NetworkManager::startReactor(int ioThreads, Reactor::FrameHandler handler) {
+    reactor = std::make_unique<Reactor>(this, ioThreads);
+    return reactor->start(std::move(handler));
+}
+
+void NetworkManager::stopReactor() {
+    if (reactor) {
+        reactor->stop();
+    }
+}
+
+bool NetworkManager::registerClient(int socket, Lobby* lobby, ClientInfo* client) {
+    if (!reactor) {
+        LOG_ERROR("❌ Reaktor neběží, socket {} nelze obsloužit", socket);
+        return false;
     }
 
-    std::cout << "✅ Přijata zpráva: " << data << std::endl;
-    return data;
+    return reactor->addConnection(socket, lobby, client);
 }
 
 bool NetworkManager::enableKeepAlive(int socket) {
     // Povolit TCP keep-alive
     int optval = 1;
     if (setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE, &optval, sizeof(optval)) < 0) {
-        std::cerr << "⚠️ Nepodařilo se povolit SO_KEEPALIVE" << std::endl;
+        LOG_WARN("⚠️ Nepodařilo se povolit SO_KEEPALIVE");
         return false;
     }
 
     #ifdef __linux__
         int keepidle = 5;  // Po 3s nečinnosti začne posílat testy
         if (setsockopt(socket, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle)) < 0) {
-            std::cerr << "⚠️ Nepodařilo se nastavit TCP_KEEPIDLE" << std::endl;
+            LOG_WARN("⚠️ Nepodařilo se nastavit TCP_KEEPIDLE");
         }
 
         int keepintvl = 5;  // Každých 3s pošle test
         if (setsockopt(socket, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl)) < 0) {
-            std::cerr << "⚠️ Nepodařilo se nastavit TCP_KEEPINTVL" << std::endl;
+            LOG_WARN("⚠️ Nepodařilo se nastavit TCP_KEEPINTVL");
         }
 
         int keepcnt = 1;  // Po 3 neúspěšných zkusí = odpojení
         if (setsockopt(socket, IPPROTO_TCP, TCP_KEEPCNT, &keepcnt, sizeof(keepcnt)) < 0) {
-            std::cerr << "⚠️ Nepodařilo se nastavit TCP_KEEPCNT" << std::endl;
+            LOG_WARN("⚠️ Nepodařilo se nastavit TCP_KEEPCNT");
         }
     #endif
 
-    std::cout << "✅ Keep-alive povolen (5 idle, 5s interval, 1 pokusy)" << std::endl;
+    LOG_INFO("✅ Keep-alive povolen (5 idle, 5s interval, 1 pokusy)");
     return true;
 }
\ No newline at end of file
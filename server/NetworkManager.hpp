@@ -1,23 +1,30 @@
 #ifndef NETWORK_MANAGER_HPP
 #define NETWORK_MANAGER_HPP
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Protocol.hpp"
+#include "Reactor.hpp"
+
+struct ClientInfo;
+class TimerWheel;
+class Metrics;
 
 // Třída zajišťující síťovou komunikaci serveru
 class NetworkManager {
 public:
 
     // Konstruktor – uloží IP adresu a port serveru
-    NetworkManager(const std::string& ip, int port);
+    NetworkManager(const std::string& ip, int port, TimerWheel* timerWheel, Metrics* metrics);
 
     // Destruktor – uvolnění prostředků
     ~NetworkManager();
 
-    // Maximální velikost síťového paketu
-    static constexpr int MAXIMUM_PACKET_SIZE = 255;
+    // Doba, po kterou klient po DISCONNECT ještě může dočíst poslední zprávy
+    static constexpr std::chrono::seconds CLOSE_GRACE{1};
 
     enum class ValidationResult {
         VALID = 0,
@@ -31,40 +38,63 @@ public:
         MESSAGE_TOO_LARGE = 8
     };
 
-    bool isValidMessageString(const std::string& data); // Kontrola stringu před deserializací
-    ValidationResult validateMessage(const Protocol::Message &msg, int clientNumber, int requiredPlayers); // Validace zprávy
-    int Validation(const Protocol::Message & msg, int clientNumber, int requiredPlayers); // Vyhadnocuje zprávu pomocí validateMessage
+    // Výsledek neblokujícího čtení rámce ze socketu
+    enum class ReadResult {
+        FRAME = 0,        // Přečten celý rámec
+        WOULD_BLOCK = 1,  // Socket zatím nemá další data
+        CLOSED = 2        // Spojení bylo uzavřeno nebo selhalo
+    };
+
+    static std::string_view validationResultName(ValidationResult result); // Název výsledku pro výpisy a metriky
+    bool isValidMessageString(std::string_view data); // Kontrola stringu před deserializací
+    ValidationResult validateMessage(const Protocol::MessageView &msg, int clientNumber, int requiredPlayers,
+                                     uint32_t lastSentID); // Validace zprávy
+    int Validation(const Protocol::MessageView & msg, int clientNumber, int requiredPlayers,
+                   uint32_t lastSentID); // Vyhadnocuje zprávu pomocí validateMessage
 
     // ===== Socket operace =====
     bool initializeSocket(); // Inicializace serverového socketu
     void closeServerSocket(); // Uzavře serverový socket
     bool enableKeepAlive(int socket); //
+    void closeSocket(int socket); // Dopošle frontu, odregistruje socket z reaktoru a uzavře ho
+    void closeSocketAfter(int socket, std::chrono::milliseconds grace = CLOSE_GRACE); // Pošle FIN po odeslání fronty, zavře po lhůtě (neblokuje)
+    void closeConnection(int socket, uint32_t generation); // Ukončí spojení reaktoru, jen pokud jde stále o stejnou registraci
+
+    // ===== Reaktor =====
+    bool startReactor(int ioThreads, Reactor::FrameHandler handler); // Spustí I/O vlákna nad epoll
+    void stopReactor(); // Zastaví I/O vlákna
+    bool registerClient(int socket, Lobby* lobby, ClientInfo* client); // Předá socket klienta reaktoru
+    Reactor::Batch batch() { return Reactor::Batch(reactor.get()); } // Dávka odpovědi – odeslání až na jejím konci
 
     // ===== Práce se zprávami =====
+    bool sendMessage(ClientInfo* client, Protocol::MessageType msgType,
+                    std::vector<std::string> msg); // Odešle zprávu klientovi (ID z jeho řady, uloží do historie)
+    bool sendPayload(ClientInfo* client, Protocol::MessageType msgType,
+                     const Protocol::Payload& payload); // Odešle předem serializovaná data (sdílená mezi příjemci)
     bool sendMessage(int socket, int clientNumber, Protocol::MessageType msgType,
-                    std::vector<std::string> msg); // Odešle zprávu klientovi podle protokolu
-    std::string receiveMessage(int socket); // Přijme zprávu od klienta
+                    std::vector<std::string> msg); // Odešle zprávu na socket bez klienta (bez historie, ID 0)
+    ReadResult receiveMessage(int socket, FrameBuffer& buffer, std::string_view& frame); // Vydá další rámec z bufferu (pohled platí do dalšího čtení)
 
     // ===== Práce s pakety =====
-    std::string findPacketByID(int clientNumber, int packetID); // Najde paket podle ID klienta a ID paketu
-    int findLatestPacketID(int clientNumber); // Vrátí ID posledního paketu pro daného klienta
+    size_t retransmit(ClientInfo* client, uint32_t lastReceivedID, bool& truncated); // Znovu pošle pakety z historie klienta
 
     // ===== Gettery =====
     int getServerSocket() const { return serverSocket; }
     int getPort() const { return port; }
-    const std::vector<std::string>& getPackets() const { return packets; }
-    int getCurrentPacketID() const { return packetID; }
 
 private:
     std::string bindIP;                            // IP adresa serveru
     int serverSocket;                              // Serverový socket
     int port;                                      // Port serveru
-    int packetID;                                  // Aktuální ID paketu
-    std::vector<std::string> packets;    // Uložené pakety
+    TimerWheel* timerWheel;                        // Plánovač odložených zavření
+    Metrics* metrics;                              // Čítače odeslaných a odmítnutých zpráv
+    std::unique_ptr<Reactor> reactor;              // Reaktor obsluhující klientské sockety
 
 
     static std::vector<std::string> getLocalIPAddresses(); // Získá seznam lokálních IP adres
-    static bool containsSuspiciousPatterns(const std::string& str); // Pomocné validační funkce
+    static bool containsSuspiciousPatterns(std::string_view str); // Pomocné validační funkce
+    bool deliver(int socket, OutboundFrame& frame); // Zařadí rámec do fronty spojení, případně pošle přímo
+    static bool sendAll(int socket, std::string_view data); // Blokující odeslání dat mimo reaktor
 };
 
 #endif // NETWORK_MANAGER_HPP
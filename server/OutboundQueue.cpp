@@ -0,0 +1,116 @@
+#include "OutboundQueue.hpp"
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+OutboundQueue::PushResult OutboundQueue::push(OutboundFrame frame) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (bytes + frame.size() > MAX_BYTES) {
+        return PushResult::OVERFLOW;
+    }
+
+    bytes += frame.size();
+    frames.push_back(std::move(frame));
+
+    if (flushing || blocked) {
+        return PushResult::QUEUED;
+    }
+
+    flushing = true;
+    return PushResult::FLUSH;
+}
+
+bool OutboundQueue::beginFlush() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (flushing) {
+        return false;
+    }
+
+    flushing = true;
+    blocked = false;
+    return true;
+}
+
+OutboundQueue::FlushResult OutboundQueue::flush(int socket) {
+    iovec iov[MAX_IOV];
+
+    while (true) {
+        int count = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (frames.empty()) {
+                flushing = false;
+                return FlushResult::DONE;
+            }
+
+            // Prvky deque se při push_back nepřesouvají a odebírá je jen vlastník flush,
+            // takže ukazatele zůstanou platné i po odemčení
+            size_t skip = offset;
+            for (auto it = frames.begin(); it != frames.end() && count + 2 <= MAX_IOV; ++it) {
+                if (skip < it->headerLength) {
+                    iov[count].iov_base = const_cast<char*>(it->headerData.data() + skip);
+                    iov[count].iov_len = it->headerLength - skip;
+                    count++;
+                    skip = 0;
+                } else {
+                    skip -= it->headerLength;
+                }
+
+                if (it->payload && skip < it->payload->size()) {
+                    iov[count].iov_base = const_cast<char*>(it->payload->data() + skip);
+                    iov[count].iov_len = it->payload->size() - skip;
+                    count++;
+                }
+                skip = 0;
+            }
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t sent = sendmsg(socket, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                blocked = true;
+                flushing = false;
+                return FlushResult::BLOCKED;
+            }
+
+            frames.clear();
+            offset = 0;
+            bytes = 0;
+            flushing = false;
+            return FlushResult::FAILED;
+        }
+
+        // Odebereme odeslané rámce, neúplný zůstane s posunutým offsetem
+        auto remaining = static_cast<size_t>(sent);
+        bytes -= remaining;
+        while (remaining > 0) {
+            size_t left = frames.front().size() - offset;
+            if (remaining < left) {
+                offset += remaining;
+                break;
+            }
+            remaining -= left;
+            frames.pop_front();
+            offset = 0;
+        }
+    }
+}
+
+size_t OutboundQueue::pendingBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
@@ -0,0 +1,73 @@
+#ifndef OUTBOUND_QUEUE_HPP
+#define OUTBOUND_QUEUE_HPP
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Odchozí rámec: hlavička konkrétního příjemce + data, která mohou sdílet všichni
+// příjemci téže zprávy (rozesílání stavu hry se serializuje jen jednou).
+// Hlavička má pevnou velikost a leží přímo v rámci – odeslání ani uložení
+// do historie kvůli ní nealokuje.
+struct OutboundFrame {
+    static constexpr size_t HEADER_CAPACITY = 24; // = Protocol::MAX_HEADER_LENGTH
+
+    std::array<char, HEADER_CAPACITY> headerData{}; // SIZE|PACKET|CLIENT|TYPE
+    size_t headerLength = 0;
+    std::shared_ptr<const std::string> payload;  // |FIELD1|...\n sdílené mezi příjemci (může být nullptr)
+
+    OutboundFrame() = default;
+    OutboundFrame(std::string_view header, std::shared_ptr<const std::string> data)
+        : payload(std::move(data)) {
+        headerLength = std::min(header.size(), HEADER_CAPACITY);
+        std::memcpy(headerData.data(), header.data(), headerLength);
+    }
+
+    std::string_view header() const { return std::string_view(headerData.data(), headerLength); }
+    size_t size() const { return headerLength + (payload ? payload->size() : 0); }
+};
+
+// Odchozí fronta jednoho spojení.
+// Rámce se jen zařadí a odesílá je vždy nejvýše jedno vlákno (vlastník flush)
+// pomocí sendmsg s více iovec najednou (hlavička a sdílená data jsou samostatné iovec). Částečný zápis pokračuje od místa,
+// kde skončil, a plný socket nikdy neblokuje – fronta pak čeká na EPOLLOUT.
+class OutboundQueue {
+public:
+    enum class PushResult {
+        FLUSH = 0,    // Volající se stal vlastníkem flush a má frontu odeslat
+        QUEUED = 1,   // Frontu odešle někdo jiný (probíhající flush nebo EPOLLOUT)
+        OVERFLOW = 2  // Fronta je plná – klient nestíhá číst
+    };
+
+    enum class FlushResult {
+        DONE = 0,     // Vše odesláno
+        BLOCKED = 1,  // Socket je plný, zbytek počká na EPOLLOUT
+        FAILED = 2    // Socket je mrtvý
+    };
+
+    static constexpr size_t MAX_BYTES = 256 * 1024; // Maximální objem neodeslaných dat
+
+    PushResult push(OutboundFrame frame); // Zařadí rámec na konec fronty
+    bool beginFlush(); // Převezme vlastnictví flush (např. po EPOLLOUT)
+    FlushResult flush(int socket); // Odešle co nejvíc dat bez blokování (jen vlastník)
+    size_t pendingBytes() const; // Objem neodeslaných dat
+
+private:
+    static constexpr int MAX_IOV = 64; // Počet iovec v jednom sendmsg (rámec zabere nejvýše dva)
+
+    mutable std::mutex mutex;        // Zámek fronty (nikdy se nedrží během sendmsg)
+    std::deque<OutboundFrame> frames; // Rámce čekající na odeslání
+    size_t offset = 0;               // Kolik bajtů prvního rámce už odešlo
+    size_t bytes = 0;                // Celkový objem neodeslaných dat
+    bool flushing = false;           // Některé vlákno frontu právě odesílá
+    bool blocked = false;            // Socket byl plný, čeká se na EPOLLOUT
+};
+
+#endif // OUTBOUND_QUEUE_HPP
@@ -0,0 +1,49 @@
+#include "PacketHistory.hpp"
+
+uint32_t PacketHistory::nextID() const {
+    return nextSequence;
+}
+
+void PacketHistory::store(const OutboundFrame& frame) {
+    frames[nextSequence % CAPACITY] = frame;
+    nextSequence++;
+}
+
+std::vector<OutboundFrame> PacketHistory::framesAfter(uint32_t lastReceivedID, bool& truncated) const {
+    std::vector<OutboundFrame> result;
+    truncated = false;
+
+    uint32_t latest = nextSequence - 1;
+    if (latest == 0) {
+        return result;
+    }
+
+    // Počet paketů, které klientovi chybí (ID je přímo sekvence, rozdíl modulo 2^32)
+    uint32_t behind = latest - lastReceivedID;
+    uint32_t stored = latest < CAPACITY ? latest : static_cast<uint32_t>(CAPACITY);
+
+    // Starší, než co buffer drží (nebo ID, které jsme nikdy neposlali) – pošleme vše uložené
+    if (behind > stored) {
+        truncated = true;
+        behind = stored;
+    }
+
+    result.reserve(behind);
+    for (uint32_t sequence = latest - behind + 1; sequence != latest + 1; sequence++) {
+        result.push_back(frames[sequence % CAPACITY]);
+    }
+    return result;
+}
+
+void PacketHistory::reset() {
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto& frame : frames) {
+        frame = OutboundFrame();
+    }
+    nextSequence = 1;
+}
+
+uint32_t PacketHistory::latestID() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return nextSequence - 1;
+}
@@ -0,0 +1,40 @@
+#ifndef PACKET_HISTORY_HPP
+#define PACKET_HISTORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OutboundQueue.hpp"
+
+// Historie odeslaných paketů jednoho klienta.
+// Každý klient má vlastní souvislou 32bitovou řadu ID (ID = sekvenční číslo,
+// 0 = zatím nic) a kruhový buffer indexovaný sekvencí, takže dohledání paketu
+// i posledního ID je O(1) a pakety ostatních klientů historii nepřepisují.
+// Řada nemá žádný sdílený čítač – každé spojení počítá jen ve vlastní historii.
+class PacketHistory {
+public:
+    static constexpr size_t CAPACITY = 64;  // Počet uchovaných paketů pro reconnect
+
+    // Zámek řady – přidělení ID, uložení a zařazení do fronty musí proběhnout
+    // pod ním, aby pořadí ID odpovídalo pořadí odeslání
+    std::unique_lock<std::mutex> lock() { return std::unique_lock<std::mutex>(mutex); }
+
+    // ===== Vyžadují držený lock() =====
+    uint32_t nextID() const; // ID, které dostane další paket
+    void store(const OutboundFrame& frame); // Uloží paket s ID nextID() a posune řadu (sdílená data se nekopírují)
+    std::vector<OutboundFrame> framesAfter(uint32_t lastReceivedID, bool& truncated) const; // Pakety po lastReceivedID (od nejstaršího)
+
+    uint32_t latestID(); // ID posledního odeslaného paketu (0 pokud žádný)
+    void reset();   // Vyprázdní historii pro novou relaci (kapacita hlaviček zůstává)
+
+private:
+    std::mutex mutex;                          // Zámek řady a bufferu
+    std::array<OutboundFrame, CAPACITY> frames; // Kruhový buffer podle sekvenčního čísla
+    uint32_t nextSequence = 1;                 // Sekvenční číslo (= ID) dalšího paketu
+};
+
+#endif // PACKET_HISTORY_HPP
@@ -1,88 +1,247 @@
 #include "Protocol.hpp"
-#include <sstream>
-#include <iostream>
-#include <iomanip>
+#include "Logger.hpp"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
 
 namespace Protocol {
 
-    std::string serialize(const Message& msg) {
-        std::stringstream ss;
+    namespace {
+        // Zapíše číslo za pozici out a vrátí ukazatel za poslední číslici
+        char* writeNumber(char* out, char* end, uint32_t value) {
+            return std::to_chars(out, end, value).ptr;
+        }
+
+        // Horní odhad hlavičky: prefix SIZE + PACKET|CLIENT|TYPE (10 + 2x 3 číslice + delimitery)
+        constexpr size_t HEADER_CAPACITY = Message::SIZE_PREFIX + 18;
+        static_assert(HEADER_CAPACITY == MAX_HEADER_LENGTH, "MAX_HEADER_LENGTH neodpovídá formátu hlavičky");
+
+        // Zapíše PACKET|CLIENT|TYPE za rezervovaný prefix SIZE
+        char* writeHeaderFields(char* out, char* end, uint32_t packetID, uint8_t clientID, MessageType type) {
+            out = writeNumber(out, end, packetID);
+            *out++ = DELIMITER;
+            out = writeNumber(out, end, clientID);
+            *out++ = DELIMITER;
+            return writeNumber(out, end, static_cast<uint32_t>(type));
+        }
+
+        // Doplní "SIZE|" zprava před obsah a vrátí začátek rámce.
+        // SIZE = délka obsahu + 6 (stejně jako dosud)
+        char* prependSize(char* base, size_t contentLength) {
+            auto totalSize = static_cast<uint16_t>(contentLength + Message::SIZE_PREFIX);
+
+            char digits[5];
+            char* digitsEnd = std::to_chars(digits, digits + sizeof(digits), totalSize).ptr;
+            size_t digitCount = digitsEnd - digits;
+
+            char* start = base + Message::SIZE_PREFIX - 1 - digitCount;
+            std::memcpy(start, digits, digitCount);
+            start[digitCount] = DELIMITER;
+            return start;
+        }
+    }
+
+    std::string_view serialize(const Message& msg, std::string& buffer) {
+        size_t capacity = HEADER_CAPACITY + 1;
+        for (const auto& field : msg.fields) {
+            capacity += 1 + field.length();
+        }
+        if (buffer.size() < capacity) {
+            buffer.resize(capacity);
+        }
 
         // Formát: SIZE|PACKET|CLIENT|TYPE|FIELD1|FIELD2|...\n
-        ss << static_cast<int>(msg.packetID) << DELIMITER
-           << static_cast<int>(msg.clientID) << DELIMITER
-           << static_cast<int>(msg.type);
+        // Obsah píšeme za rezervovaný prefix, SIZE pak doplníme zprava před něj
+        char* base = buffer.data();
+        char* end = base + buffer.size();
+        char* out = writeHeaderFields(base + Message::SIZE_PREFIX, end, msg.packetID, msg.clientID, msg.type);
 
-        // Přidáme fields
         for (const auto& field : msg.fields) {
-            ss << DELIMITER << field;
+            *out++ = DELIMITER;
+            std::memcpy(out, field.data(), field.length());
+            out += field.length();
         }
-        ss << TERMINATOR;
+        *out++ = TERMINATOR;
 
-        std::string content = ss.str();
+        char* start = prependSize(base, out - (base + Message::SIZE_PREFIX));
+        return std::string_view(start, out - start);
+    }
 
-        // Nyní přidáme SIZE na začátek
-        uint16_t total_size = content.length() + 6;  // +6 pro "SIZE|" (max 5 číslic + |)
+    Payload serializePayload(const std::vector<std::string>& fields) {
+        size_t length = 1;
+        for (const auto& field : fields) {
+            length += 1 + field.length();
+        }
 
-        std::stringstream final;
-        final << total_size << DELIMITER << content;
+        std::string payload;
+        payload.reserve(length);
+        for (const auto& field : fields) {
+            payload += DELIMITER;
+            payload += field;
+        }
+        payload += TERMINATOR;
 
-        return final.str();
+        return std::make_shared<const std::string>(std::move(payload));
     }
 
-    Message deserialize(const std::string& data) {
+    std::string_view serializeHeader(uint32_t packetID, uint8_t clientID, MessageType type,
+                                     size_t payloadLength, std::string& buffer) {
+        if (buffer.size() < HEADER_CAPACITY) {
+            buffer.resize(HEADER_CAPACITY);
+        }
+
+        char* base = buffer.data();
+        char* out = writeHeaderFields(base + Message::SIZE_PREFIX, base + buffer.size(), packetID, clientID, type);
+
+        // SIZE započítává i sdílená data, která se pošlou za hlavičkou
+        char* start = prependSize(base, (out - (base + Message::SIZE_PREFIX)) + payloadLength);
+        return std::string_view(start, out - start);
+    }
+
+    std::string serialize(const Message& msg) {
+        thread_local std::string buffer;
+        return std::string(serialize(msg, buffer));
+    }
+
+    std::string_view MessageView::at(size_t index) const {
+        if (index >= fieldCount) {
+            throw std::out_of_range("MessageView::at");
+        }
+        return fields[index];
+    }
+
+    Message MessageView::toMessage() const {
         Message msg;
+        msg.size = size;
+        msg.packetID = packetID;
+        msg.clientID = clientID;
+        msg.type = type;
+        msg.fields.reserve(fieldCount);
+        for (size_t i = 0; i < fieldCount; i++) {
+            msg.fields.emplace_back(fields[i]);
+        }
+        return msg;
+    }
+
+    bool parseNumber(std::string_view text, int& value) {
+        const char* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    bool parseNumber(std::string_view text, uint32_t& value) {
+        const char* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    namespace {
+        // Číslo hlavičky v rozsahu 0..max
+        bool parseHeaderNumber(std::string_view text, uint32_t max, uint32_t& value) {
+            return parseNumber(text, value) && value <= max;
+        }
+    }
+
+    bool parse(std::string_view data, MessageView& view) {
+        view = MessageView{};
 
         if (data.empty()) {
-            std::cerr << "❌ [PROTOCOL] Prázdná zpráva" << std::endl;
-            return msg;
+            LOG_ERROR("❌ [PROTOCOL] Prázdná zpráva");
+            return false;
+        }
+
+        // Terminátor není součástí posledního pole
+        if (data.back() == TERMINATOR) {
+            data.remove_suffix(1);
         }
 
-        // Rozdělíme podle delimiteru
-        std::vector<std::string> parts;
-        std::stringstream ss(data);
-        std::string token;
+        // Jeden průchod: hlavička SIZE|PACKET|CLIENT|TYPE, zbytek jsou pole
+        std::array<uint32_t, 4> header{};
+        size_t part = 0;
+        size_t start = 0;
+
+        while (true) {
+            size_t end = data.find(DELIMITER, start);
+            std::string_view token = data.substr(start, end == std::string_view::npos
+                                                            ? std::string_view::npos
+                                                            : end - start);
+
+            if (part < header.size()) {
+                static constexpr uint32_t limits[] = {MAX_MESSAGE_SIZE, UINT32_MAX, 255, 255};
+                if (!parseHeaderNumber(token, limits[part], header[part])) {
+                    LOG_ERROR("❌ [PROTOCOL] Chyba při parsování hlavičky (část {})", part);
+                    return false;
+                }
+            } else {
+                if (view.fieldCount == MAX_FIELDS) {
+                    LOG_ERROR("❌ [PROTOCOL] Příliš mnoho polí (max {})", MAX_FIELDS);
+                    return false;
+                }
+                view.fields[view.fieldCount++] = token;
+            }
+            part++;
 
-        while (std::getline(ss, token, DELIMITER)) {
-            // Odstraníme \n z posledního tokenu
-            if (!token.empty() && token.back() == TERMINATOR) {
-                token.pop_back();
+            if (end == std::string_view::npos) {
+                break;
             }
-            parts.push_back(token);
+            start = end + 1;
         }
 
         // Minimálně potřebujeme: SIZE|PACKET|CLIENT|TYPE
-        if (parts.size() < 4) {
-            std::cerr << "❌ [PROTOCOL] Neplatný počet částí: " << parts.size() << std::endl;
-            return msg;
+        if (part < header.size()) {
+            LOG_ERROR("❌ [PROTOCOL] Neplatný počet částí: {}", part);
+            return false;
         }
 
-        try {
-            // Parsování hlavičky
-            msg.size = std::stoi(parts[0]);
-            msg.packetID = std::stoi(parts[1]);
-            msg.clientID = std::stoi(parts[2]);
-            msg.type = static_cast<MessageType>(std::stoi(parts[3]));
-
-            // Zbylé části jsou fields
-            for (size_t i = 4; i < parts.size(); i++) {
-                msg.fields.push_back(parts[i]);
-            }
+        view.size = static_cast<uint16_t>(header[0]);
+        view.packetID = header[1];
+        view.clientID = static_cast<uint8_t>(header[2]);
+        view.type = static_cast<MessageType>(header[3]);
+        return true;
+    }
 
-        } catch (const std::exception& e) {
-            std::cerr << "❌ [PROTOCOL] Chyba při parsování: " << e.what() << std::endl;
+    Message deserialize(const std::string& data) {
+        MessageView view;
+        if (!parse(data, view)) {
+            return Message();
         }
+        return view.toMessage();
+    }
 
-        return msg;
+    std::string_view messageTypeName(MessageType type) {
+        switch (type) {
+            case MessageType::STATUS: return "STATUS";
+            case MessageType::WELCOME: return "WELCOME";
+            case MessageType::STATE: return "STATE";
+            case MessageType::GAME_START: return "GAME_START";
+            case MessageType::RESULT: return "RESULT";
+            case MessageType::DISCONNECT: return "DISCONNECT";
+            case MessageType::CLIENT_DATA: return "CLIENT_DATA";
+            case MessageType::YOUR_TURN: return "YOUR_TURN";
+            case MessageType::WAIT_LOBBY: return "WAIT_LOBBY";
+            case MessageType::WAIT: return "WAIT";
+            case MessageType::INVALID: return "INVALID";
+            case MessageType::AUTHORIZE: return "AUTHORIZE";
+            case MessageType::RECONNECT: return "RECONNECT";
+            case MessageType::CONNECT: return "CONNECT";
+            case MessageType::CARD: return "CARD";
+            case MessageType::TRICK: return "TRICK";
+            case MessageType::BIDDING: return "BIDDING";
+            case MessageType::RESET: return "RESET";
+            case MessageType::PING: return "PING";
+            case MessageType::PONG: return "PONG";
+            case MessageType::STATE_DELTA: return "STATE_DELTA";
+        }
+        return "UNKNOWN";
     }
 
-    Message createMessage(int packetID, int clientID, MessageType type,
-                         const std::vector<std::string>& fields) {
+    Message createMessage(uint32_t packetID, int clientID, MessageType type,
+                         std::vector<std::string> fields) {
         return Message(
-            static_cast<uint8_t>(packetID),
+            packetID,
             static_cast<uint8_t>(clientID),
             type,
-            fields
+            std::move(fields)
         );
     }
 }
\ No newline at end of file
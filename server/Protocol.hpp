@@ -1,12 +1,15 @@
 #ifndef PROTOCOL_HPP
 #define PROTOCOL_HPP
 
+#include <array>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <cstdint>
-#include <sstream>
 
-// Struktura zprávy: [ Velikost (2B) | ID Packetu (1B) | Data (xB) ]
+// Struktura zprávy: [ Velikost (2B) | ID Packetu (4B) | Data (xB) ]
 namespace Protocol {
 
     // Typy zpráv (stejné jako předtím)
@@ -31,56 +34,86 @@ namespace Protocol {
         RESET = 18,
         PING = 19,
         PONG = 20,
+        STATE_DELTA = 21,  // Změny stavu od předchozí verze (jen server -> klient s ohlášenou schopností)
     };
 
     // Konstanty
     constexpr char DELIMITER = '|';
     constexpr char TERMINATOR = '\n';
     constexpr uint16_t MAX_MESSAGE_SIZE = 65535;
+    constexpr size_t MAX_FIELDS = 16;  // Maximální počet datových polí přijaté zprávy
+    constexpr size_t MAX_HEADER_LENGTH = 24;  // Nejdelší hlavička SIZE|PACKET|CLIENT|TYPE (5 + 10 + 2x 3 číslice + delimitery)
+
+    // Schopnosti ohlašované klientem v CONNECT (pole za přezdívkou)
+    constexpr std::string_view CAPABILITY_DELTA_STATE = "delta";  // Klient umí STATE_DELTA
 
     // Struktura zprávy
     struct Message {
-        uint16_t size{};          // Celková velikost
-        uint8_t packetID;       // ID packetu
+        uint16_t size{};          // Celková velikost (jen u přijaté zprávy – při odeslání ji doplní serializace)
+        uint32_t packetID;      // ID packetu (sekvence spojení)
         uint8_t clientID;       // ID klienta
         MessageType type;       // Typ zprávy
         std::vector<std::string> fields;  // Data
 
         Message() : packetID(0), clientID(0), type(MessageType::STATUS) {}
 
-        Message(uint8_t pID, uint8_t cID, MessageType t, const std::vector<std::string>& data)
-            : packetID(pID), clientID(cID), type(t), fields(data) {
+        Message(uint32_t pID, uint8_t cID, MessageType t, std::vector<std::string> data)
+            : packetID(pID), clientID(cID), type(t), fields(std::move(data)) {}
 
-            // Vypočítáme velikost
-            calculateSize();
-        }
+        static constexpr size_t SIZE_PREFIX = 6;  // Místo pro "SIZE|" (max 5 číslic + delimiter)
+    };
 
-        void calculateSize() {
-            // Format: SIZE|PACKET|CLIENT|TYPE|FIELD1|FIELD2|...\n
-            std::stringstream ss;
-            ss << "00000" << DELIMITER  // Placeholder pro SIZE (max 5 číslic)
-               << static_cast<int>(packetID) << DELIMITER
-               << static_cast<int>(clientID) << DELIMITER
-               << static_cast<int>(type);
+    // Pohled na přijatou zprávu – pole ukazují přímo do přijímacího bufferu
+    // a platí jen do jeho další změny. Co si handler ponechává, musí zkopírovat.
+    struct MessageView {
+        uint16_t size{};        // Celková velikost
+        uint32_t packetID{};    // ID packetu (sekvence spojení)
+        uint8_t clientID{};     // ID klienta
+        MessageType type{MessageType::STATUS};  // Typ zprávy
+        std::array<std::string_view, MAX_FIELDS> fields{};  // Data
+        size_t fieldCount{};    // Počet platných polí
 
-            for (const auto& field : fields) {
-                ss << DELIMITER << field;
-            }
-            ss << TERMINATOR;
+        // Pole s kontrolou rozsahu (jako std::vector::at)
+        std::string_view at(size_t index) const;
 
-            size = ss.str().length();
-        }
+        // Vlastnící kopie zprávy
+        Message toMessage() const;
     };
 
-    // Serializace zprávy do stringu
+    // Serializace zprávy do bufferu volajícího (bez alokace, pokud má buffer dost místa).
+    // Vrácený pohled ukazuje do bufferu a platí do jeho další změny.
+    std::string_view serialize(const Message& msg, std::string& buffer);
+
+    // Serializace zprávy do stringu (používá buffer vlákna)
     std::string serialize(const Message& msg);
 
-    // Deserializace stringu na zprávu
+    // Sdílená data zprávy "|FIELD1|FIELD2|...\n" – při rozesílání stejné zprávy
+    // více klientům se serializují jednou, každý příjemce dostane jen vlastní hlavičku
+    using Payload = std::shared_ptr<const std::string>;
+    Payload serializePayload(const std::vector<std::string>& fields);
+
+    // Hlavička příjemce "SIZE|PACKET|CLIENT|TYPE" k datům délky payloadLength.
+    // Hlavička + data dávají stejný rámec jako serialize() celé zprávy.
+    std::string_view serializeHeader(uint32_t packetID, uint8_t clientID, MessageType type,
+                                     size_t payloadLength, std::string& buffer);
+
+    // Jednoprůchodové parsování rámce bez alokací a výjimek.
+    // Vrací false, pokud rámec neodpovídá formátu SIZE|PACKET|CLIENT|TYPE|...
+    bool parse(std::string_view data, MessageView& view);
+
+    // Převod celého pole na číslo (bez výjimek)
+    bool parseNumber(std::string_view text, int& value);
+    bool parseNumber(std::string_view text, uint32_t& value);
+
+    // Deserializace stringu na zprávu (vlastnící kopie polí)
     Message deserialize(const std::string& data);
 
+    // Název typu zprávy pro výpisy a metriky ("UNKNOWN" pro neznámý typ)
+    std::string_view messageTypeName(MessageType type);
+
     // Helper funkce pro vytvoření zprávy
-    Message createMessage(int packetID, int clientID, MessageType type,
-                         const std::vector<std::string>& fields);
+    Message createMessage(uint32_t packetID, int clientID, MessageType type,
+                         std::vector<std::string> fields);
 }
 
 #endif
\ No newline at end of file
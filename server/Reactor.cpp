@@ -0,0 +1,434 @@
+#include "Reactor.hpp"
+#include "NetworkManager.hpp"
+#include "ClientManager.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    constexpr uint64_t WAKE_KEY = UINT64_MAX;      // Klíč eventfd pro probuzení vláken
+    constexpr uint64_t WRITE_KEY = UINT64_MAX - 1; // Klíč write-epoll vnořené do hlavní epoll
+    constexpr uint32_t CONNECTION_EVENTS = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    constexpr uint32_t WRITE_EVENTS = EPOLLOUT | EPOLLONESHOT;
+
+    // Klíč události = generace (horních 32 bitů) + socket (dolních 32 bitů)
+    uint64_t makeKey(int socket, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(socket);
+    }
+
+    // Během dávky (zpracování rámců, akce časovače...) se odesílání jen řadí a spojení,
+    // jejichž flush toto vlákno převzalo, se odešlou najednou na jejím konci
+    thread_local int deferDepth = 0;
+    thread_local std::vector<std::shared_ptr<Connection>> deferredConnections;
+}
+
+Connection::~Connection() {
+    if (socket >= 0) {
+        close(socket);
+    }
+}
+
+Reactor::Reactor(NetworkManager* networkManager, int ioThreads)
+    : networkManager(networkManager), ioThreadCount(ioThreads), epollFd(-1), writeEpollFd(-1),
+      wakeFd(-1), running(false), nextGeneration(1) {
+
+    LOG_INFO("🔧 Reactor vytvořen ({} I/O vláken)", ioThreadCount);
+}
+
+Reactor::~Reactor() {
+    stop();
+}
+
+bool Reactor::start(FrameHandler handler) {
+    frameHandler = std::move(handler);
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    writeEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || writeEpollFd < 0 || wakeFd < 0) {
+        LOG_ERROR("❌ Nepodařilo se vytvořit epoll/eventfd: {}", strerror(errno));
+        stop();
+        return false;
+    }
+
+    // eventfd je level-triggered a nikdo ho nečte – po zápisu probudí všechna vlákna
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKE_KEY;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+    // Write-epoll je čitelná, kdykoli se některý čekající socket uvolní
+    ev.events = EPOLLIN;
+    ev.data.u64 = WRITE_KEY;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, writeEpollFd, &ev);
+
+    running = true;
+    for (int i = 0; i < ioThreadCount; i++) {
+        ioThreads.emplace_back(&Reactor::ioLoop, this);
+    }
+
+    LOG_INFO("✅ Reactor spuštěn ({} I/O vláken)", ioThreadCount);
+    return true;
+}
+
+void Reactor::stop() {
+    if (running.exchange(false)) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            LOG_WARN("⚠️ Nepodařilo se probudit I/O vlákna");
+        }
+
+        for (auto& thread : ioThreads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        ioThreads.clear();
+        LOG_INFO("🛑 Reactor zastaven");
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    for (int* fd : {&wakeFd, &writeEpollFd, &epollFd}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+// ============================================================
+// REGISTRACE SPOJENÍ
+// ============================================================
+bool Reactor::addConnection(int socket, Lobby* lobby, ClientInfo* client) {
+    auto conn = std::make_shared<Connection>();
+    conn->lobby = lobby;
+    conn->client = client;
+    conn->clientGeneration = client ? client->generation.load() : 0;
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    if (epollFd < 0) {
+        return false;
+    }
+
+    conn->generation = nextGeneration++;
+
+    epoll_event ev{};
+    ev.events = CONNECTION_EVENTS;
+    ev.data.u64 = makeKey(socket, conn->generation);
+
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &ev) < 0) {
+        LOG_ERROR("❌ Nepodařilo se registrovat socket {} do epoll: {}", socket, strerror(errno));
+        return false;
+    }
+
+    // Od teď socket vlastní spojení a uzavře ho ve svém destruktoru
+    conn->socket = socket;
+    connections[socket] = conn;
+    return true;
+}
+
+bool Reactor::removeConnection(int socket) {
+    auto conn = find(socket);
+    if (!conn) {
+        return false;
+    }
+
+    // Frontu (typicky DISCONNECT) musí nejdřív doposlat vlastník flush – dávka tohoto
+    // vlákna, jiné vlákno, nebo my, pokud flush nikdo nevlastní. Spojení odregistruje
+    // ten, kdo flush dokončí (viz flushConnection), takže socket nezavřeme pod rukama
+    // jinému vláknu. Příznak se nastaví před beginFlush – vlastník, který flush
+    // uvolní až po něm, ho tak vždy uvidí.
+    conn->closing = true;
+    conn->detachPending = true;
+
+    bool owned = std::find(deferredConnections.begin(), deferredConnections.end(), conn)
+                 != deferredConnections.end();
+    if (!owned && conn->output.beginFlush()) {
+        flushConnection(conn);
+    }
+    return true;
+}
+
+bool Reactor::removeConnection(int socket, uint32_t generation) {
+    auto conn = find(socket);
+    if (!conn || conn->generation != generation) {
+        return false;  // Spojení už skončilo a číslo socketu patří jiné registraci
+    }
+    return removeConnection(socket);
+}
+
+bool Reactor::beginClose(int socket, uint32_t& generation) {
+    auto conn = find(socket);
+    if (!conn) {
+        return false;
+    }
+
+    generation = conn->generation;
+    conn->closing = true;
+
+    // Frontu odešle vlastník flush a po jejím vyprázdnění zavře zápis (viz flushConnection)
+    bool owned = std::find(deferredConnections.begin(), deferredConnections.end(), conn)
+                 != deferredConnections.end();
+    if (!owned && conn->output.beginFlush()) {
+        flushConnection(conn);
+    }
+    return true;
+}
+
+bool Reactor::detach(const std::shared_ptr<Connection>& conn) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+
+    auto it = connections.find(conn->socket);
+    if (it == connections.end() || it->second != conn) {
+        return false;
+    }
+
+    conn->closed = true;
+    if (epollFd >= 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->socket, nullptr);
+    }
+    if (conn->writeRegistered && writeEpollFd >= 0) {
+        epoll_ctl(writeEpollFd, EPOLL_CTL_DEL, conn->socket, nullptr);
+    }
+    connections.erase(it);
+
+    // Samotné close proběhne v destruktoru spojení, až ho nikdo nepoužívá
+    shutdown(conn->socket, SHUT_RDWR);
+    return true;
+}
+
+size_t Reactor::getConnectionCount() {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    return connections.size();
+}
+
+std::shared_ptr<Connection> Reactor::find(int socket) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    auto it = connections.find(socket);
+    if (it == connections.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::shared_ptr<Connection> Reactor::lookup(uint64_t key) {
+    int socket = static_cast<int>(key & 0xFFFFFFFFu);
+    auto generation = static_cast<uint32_t>(key >> 32);
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    auto it = connections.find(socket);
+    if (it == connections.end() || it->second->generation != generation) {
+        return nullptr;  // Zastaralá událost pro už uzavřené spojení
+    }
+    return it->second;
+}
+
+void Reactor::rearm(const std::shared_ptr<Connection>& conn) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+
+    // Uzavřené spojení už nesmíme přezbrojit
+    if (conn->closed || epollFd < 0) {
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = CONNECTION_EVENTS;
+    ev.data.u64 = makeKey(conn->socket, conn->generation);
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, conn->socket, &ev);
+}
+
+// ============================================================
+// ODCHOZÍ FRONTY
+// ============================================================
+Reactor::QueueResult Reactor::queueFrame(int socket, OutboundFrame& frame) {
+    auto conn = find(socket);
+    if (!conn) {
+        return QueueResult::UNKNOWN_SOCKET;
+    }
+
+    switch (conn->output.push(std::move(frame))) {
+        case OutboundQueue::PushResult::QUEUED:
+            return QueueResult::QUEUED;
+
+        case OutboundQueue::PushResult::OVERFLOW:
+            LOG_ERROR("❌ Socket {} nestíhá číst ({} B ve frontě), odpojuji", socket, conn->output.pendingBytes());
+            failConnection(conn);
+            return QueueResult::DROPPED;
+
+        case OutboundQueue::PushResult::FLUSH:
+            break;
+    }
+
+    // Během handleru jen zapamatovat – odešle se vše najednou po jeho návratu
+    if (deferDepth > 0) {
+        deferredConnections.push_back(conn);
+        return QueueResult::QUEUED;
+    }
+
+    flushConnection(conn);
+    return conn->closed ? QueueResult::DROPPED : QueueResult::QUEUED;
+}
+
+void Reactor::flushConnection(const std::shared_ptr<Connection>& conn) {
+    if (conn->closed) {
+        return;
+    }
+
+    switch (conn->output.flush(conn->socket)) {
+        case OutboundQueue::FlushResult::DONE:
+            // Zavírané spojení: klient dostane FIN až po posledním rámci
+            if (conn->closing) {
+                shutdown(conn->socket, SHUT_WR);
+            }
+            break;
+
+        case OutboundQueue::FlushResult::BLOCKED:
+            armWritable(conn);
+            break;
+
+        case OutboundQueue::FlushResult::FAILED:
+            LOG_ERROR("❌ Send selhal, socket {} mrtvý", conn->socket);
+            failConnection(conn);
+            break;
+    }
+
+    // Spojení čeká na odregistrování (removeConnection) – fronta je odeslaná, nebo
+    // se na plný či mrtvý socket už čekat nebude
+    if (conn->detachPending) {
+        detach(conn);
+    }
+}
+
+void Reactor::armWritable(const std::shared_ptr<Connection>& conn) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+
+    if (conn->closed || writeEpollFd < 0) {
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = WRITE_EVENTS;
+    ev.data.u64 = makeKey(conn->socket, conn->generation);
+
+    int op = conn->writeRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(writeEpollFd, op, conn->socket, &ev) == 0) {
+        conn->writeRegistered = true;
+    }
+}
+
+void Reactor::failConnection(const std::shared_ptr<Connection>& conn) {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+
+    // Jen shutdown – čtecí strana uvidí konec spojení a projde běžným odpojením
+    if (!conn->closed) {
+        shutdown(conn->socket, SHUT_RDWR);
+    }
+}
+
+Reactor::Batch::Batch(Reactor* reactor) : reactor(reactor) {
+    if (reactor) {
+        deferDepth++;
+    }
+}
+
+Reactor::Batch::~Batch() {
+    if (reactor && --deferDepth == 0) {
+        reactor->flushDeferred();
+    }
+}
+
+void Reactor::flushDeferred() {
+    std::vector<std::shared_ptr<Connection>> pending;
+    pending.swap(deferredConnections);
+
+    for (auto& conn : pending) {
+        flushConnection(conn);
+    }
+}
+
+// ============================================================
+// I/O SMYČKA
+// ============================================================
+void Reactor::ioLoop() {
+    epoll_event events[MAX_EVENTS];
+
+    while (running) {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("❌ epoll_wait selhal: {}", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < n && running; i++) {
+            uint64_t key = events[i].data.u64;
+            if (key == WAKE_KEY) {
+                continue;
+            }
+            if (key == WRITE_KEY) {
+                handleWritable();
+                continue;
+            }
+
+            auto conn = lookup(key);
+            if (conn) {
+                handleReadable(conn);
+            }
+        }
+    }
+}
+
+void Reactor::handleWritable() {
+    epoll_event events[MAX_EVENTS];
+
+    int n = epoll_wait(writeEpollFd, events, MAX_EVENTS, 0);
+    for (int i = 0; i < n; i++) {
+        auto conn = lookup(events[i].data.u64);
+        if (conn && conn->output.beginFlush()) {
+            flushConnection(conn);
+        }
+    }
+}
+
+void Reactor::handleReadable(const std::shared_ptr<Connection>& conn) {
+    std::string_view frame;
+
+    // Odpovědi na všechny přečtené rámce odejdou po zpracování najednou
+    Batch batch(this);
+    while (!conn->closed) {
+        auto result = networkManager->receiveMessage(conn->socket, conn->input, frame);
+
+        if (result == NetworkManager::ReadResult::WOULD_BLOCK) {
+            rearm(conn);
+            break;
+        }
+
+        if (result == NetworkManager::ReadResult::CLOSED) {
+            // U zavíraného spojení už klienta odpojil server – handler nevoláme
+            if (conn->closing) {
+                detach(conn);
+                break;
+            }
+
+            // Spojení zůstane registrované (číslo fd se nerecykluje), dokud ho vlastník
+            // klienta neukončí přes removeConnection – ztrátu může zpracovat později
+            frameHandler(*conn, std::string_view());
+            break;
+        }
+
+        // Zavírané spojení jen dočítá data do konce (aby close neposlal RST)
+        if (conn->closing) {
+            continue;
+        }
+
+        frameHandler(*conn, frame);
+    }
+}
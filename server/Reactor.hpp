@@ -0,0 +1,127 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameBuffer.hpp"
+#include "OutboundQueue.hpp"
+
+// Forward deklarace
+struct Lobby;
+struct ClientInfo;
+class NetworkManager;
+
+// Stav jednoho klientského spojení obsluhovaného reaktorem.
+// CONNECT/RECONNECT zpracuje strand místnosti; dokud běží, spojení patří jemu
+// a lobby/client/clientGeneration zapisuje jen on (zveřejní je přechodem do DONE).
+struct Connection : std::enable_shared_from_this<Connection> {
+    enum class Handshake {
+        NONE,    // Čeká se na CONNECT/RECONNECT
+        PENDING, // Handshake běží na strandu místnosti
+        DONE,    // Spojení obsluhuje autorizovaného klienta
+        LOST     // Spojení spadlo během handshaku – odpojení provede jeho dokončení
+    };
+
+    int socket = -1;                  // Socket klienta
+    uint32_t generation = 0;          // Generace registrace (ochrana proti recyklaci čísla fd)
+    Lobby* lobby = nullptr;           // Místnost, do které spojení patří
+    ClientInfo* client = nullptr;     // Klient obsluhovaný tímto spojením
+    uint32_t clientGeneration = 0;    // Generace relace klienta (slot se po odpojení recykluje)
+    std::atomic<Handshake> handshake{Handshake::NONE}; // Fáze CONNECT/RECONNECT
+    bool muted = false;               // Klienta odpojuje strand – další rámce se zahazují (jen I/O vlákno)
+    FrameBuffer input;                // Přijatá data včetně neúplného rámce
+    OutboundQueue output;             // Rámce čekající na odeslání
+    bool writeRegistered = false;     // Socket je ve write-epoll (chráněno zámkem reaktoru)
+    std::atomic<bool> closed{false};  // Spojení bylo odregistrováno z reaktoru
+    std::atomic<bool> closing{false}; // Po odeslání fronty se zavře zápis, příchozí data se zahazují
+    std::atomic<bool> detachPending{false}; // Po dokončení flush se spojení odregistruje (removeConnection)
+
+    Connection() = default;
+    ~Connection(); // Socket se uzavře až ho nikdo nepoužívá (číslo fd nejde recyklovat dřív)
+};
+
+// Reaktor nad epoll – pevná sada I/O vláken obsluhuje všechny klientské sockety.
+// Každý socket je registrován s EPOLLONESHOT, takže jedno spojení v danou chvíli
+// obsluhuje nejvýše jedno vlákno a pořadí zpráv od klienta zůstává zachováno.
+class Reactor {
+public:
+    // Handler dostane kompletní rámec (pohled do bufferu spojení, platí jen během volání);
+    // prázdný rámec znamená ztrátu spojení – to pak musí ukončit handler (removeConnection)
+    using FrameHandler = std::function<void(Connection&, std::string_view)>;
+
+    // Dávka odpovědi – dokud existuje, odesílání z tohoto vlákna se jen řadí do front
+    // a každé dotčené spojení se na jejím konci odešle jedním zápisem (všechny rámce
+    // s vlastními ID v původním pořadí). Dávky lze vnořovat, odesílá až ta vnější.
+    class Batch {
+    public:
+        explicit Batch(Reactor* reactor); // nullptr = bez reaktoru, dávka nic nedělá
+        ~Batch();
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        Reactor* reactor;
+    };
+
+    enum class QueueResult {
+        QUEUED = 0,          // Rámec je ve frontě spojení
+        UNKNOWN_SOCKET = 1,  // Socket reaktor neobsluhuje
+        DROPPED = 2          // Spojení nestíhá číst nebo je mrtvé – bude odpojeno
+    };
+
+    Reactor(NetworkManager* networkManager, int ioThreads);
+    ~Reactor();
+
+    bool start(FrameHandler handler); // Vytvoří epoll a spustí I/O vlákna
+    void stop(); // Zastaví a připojí I/O vlákna
+
+    bool addConnection(int socket, Lobby* lobby, ClientInfo* client); // Začne obsluhovat socket
+    bool removeConnection(int socket); // Ukončí spojení, jakmile se dopošle fronta (socket uzavře)
+    bool removeConnection(int socket, uint32_t generation); // Totéž, jen pokud jde stále o stejnou registraci
+    bool beginClose(int socket, uint32_t& generation); // Zahájí odložené zavření (FIN po odeslání fronty)
+    QueueResult queueFrame(int socket, OutboundFrame& frame); // Zařadí rámec do odchozí fronty spojení
+
+    // Gettery
+    int getThreadCount() const { return ioThreadCount; }
+    size_t getConnectionCount();
+
+private:
+    static constexpr int MAX_EVENTS = 8; // Počet událostí zpracovaných jedním vláknem naráz
+
+    NetworkManager* networkManager;
+    int ioThreadCount;                   // Počet I/O vláken
+    int epollFd;                         // Sdílená epoll instance
+    int writeEpollFd;                    // Epoll se sockety čekajícími na EPOLLOUT
+    int wakeFd;                          // eventfd pro probuzení vláken při zastavení
+    std::atomic<bool> running;           // Příznak běhu reaktoru
+    FrameHandler frameHandler;           // Zpracování přijatých rámců
+    std::vector<std::thread> ioThreads;  // I/O vlákna
+
+    std::unordered_map<int, std::shared_ptr<Connection>> connections; // Registrovaná spojení podle socketu
+    std::mutex connectionsMutex;         // Zámek pro tabulku spojení a přezbrojení epoll
+    uint32_t nextGeneration;             // Čítač generací registrací
+
+    void ioLoop(); // Smyčka jednoho I/O vlákna
+    void handleReadable(const std::shared_ptr<Connection>& conn); // Přečte a zpracuje všechny celé rámce
+    void handleWritable(); // Dopošle fronty socketů, které se uvolnily
+    void rearm(const std::shared_ptr<Connection>& conn); // Znovu povolí události pro spojení
+    bool detach(const std::shared_ptr<Connection>& conn); // Odregistruje konkrétní spojení
+    void flushConnection(const std::shared_ptr<Connection>& conn); // Odešle frontu (jen vlastník flush), případně odregistruje spojení
+    void armWritable(const std::shared_ptr<Connection>& conn); // Počká na uvolnění socketu
+    void failConnection(const std::shared_ptr<Connection>& conn); // Ukončí nefunkční spojení
+    void flushDeferred(); // Odešle fronty nasbírané během dávky
+    std::shared_ptr<Connection> lookup(uint64_t key); // Najde spojení podle klíče z epoll
+    std::shared_ptr<Connection> find(int socket); // Najde spojení podle socketu
+};
+
+#endif // REACTOR_HPP
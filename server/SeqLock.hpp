@@ -0,0 +1,72 @@
+#ifndef SEQ_LOCK_HPP
+#define SEQ_LOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Hodnota zveřejňovaná jedním zapisovatelem pro libovolně mnoho čtenářů.
+// Zapisovatel před zápisem nastaví liché sekvenční číslo a po zápisu sudé,
+// čtenář kopii zopakuje, pokud se sekvence mezitím změnila. Čtení nikdy
+// nebere zámek ani nezdrží zapisovatele. Data jsou uložená po 64bitových
+// atomických slovech, takže souběžné čtení rozepsané hodnoty není data race.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock vyžaduje trivially copyable typ");
+
+public:
+    SeqLock() : sequence(0) {
+        for (auto& word : words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Jen jeden zapisovatel současně (např. strand místnosti)
+    void store(const T& value) {
+        std::array<uint64_t, WORDS> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+
+        uint64_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    // Libovolné vlákno – vrátí naposledy celou zapsanou hodnotu
+    T load() const {
+        std::array<uint64_t, WORDS> buffer{};
+        uint64_t before;
+        uint64_t after;
+
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence;                // Liché = zápis probíhá
+    std::array<std::atomic<uint64_t>, WORDS> words; // Hodnota rozdělená na slova
+};
+
+#endif // SEQ_LOCK_HPP
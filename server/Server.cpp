@@ -1,31 +1,63 @@
 #include "Server.hpp"
+#include "Logger.hpp"
 #include <arpa/inet.h>
-#include <iostream>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+namespace {
+    // Stav místností je víceřádkový a dlouhý – loguje se po řádcích,
+    // aby se žádný nezkrátil na velikost záznamu loggeru
+    void logLobbiesStatus(LobbyManager* lobbyManager) {
+        if (!Logger::enabled(LogLevel::INFO)) {
+            return;
+        }
+
+        std::string status = lobbyManager->getLobbiesStatus();
+        std::string_view text = status;
+        while (!text.empty()) {
+            size_t end = std::min(text.find('\n'), text.size());
+            if (end > 0) {
+                LOG_INFO("{}", text.substr(0, end));
+            }
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+    }
+}
+
 // ============================================================
 // KONSTRUKTOR A DESTRUKTOR
 // ============================================================
 GameServer::GameServer(const std::string &ip, int port, int requiredPlayers,
-                       int lobbies)
-    : networkManager(
-          std::make_unique<NetworkManager>(ip, port)),
+                       int maxLobbies, int ioThreads, int gameThreads, int adminPort)
+    : metrics(std::make_unique<Metrics>()),
+      timerWheel(std::make_unique<TimerWheel>()),
+      networkManager(
+          std::make_unique<NetworkManager>(ip, port, timerWheel.get(), metrics.get())),
+      workerPool(std::make_unique<WorkerPool>(gameThreads)),
+      sessionPool(std::make_unique<SessionPool>(SessionPool::BLOCK_SIZE)),
           ip(ip),
           port(port), running(false), requiredPlayers(requiredPlayers),
-          lobbyCount(lobbies) {
-  std::cout << "🔧 GameServer vytvořen" << std::endl;
-  std::cout << "   - IP adresa: " << ip << std::endl;
-  std::cout << "   - Port: " << port << std::endl;
-  std::cout << "   - Počet hráčů: " << requiredPlayers << std::endl;
-  std::cout << "   - Počet místností: " << lobbies << std::endl;
+          maxLobbies(maxLobbies), ioThreads(ioThreads), gameThreads(gameThreads),
+          adminPort(adminPort) {
+  LOG_INFO("🔧 GameServer vytvořen");
+  LOG_INFO("   - IP adresa: {}", ip);
+  LOG_INFO("   - Port: {}", port);
+  LOG_INFO("   - Počet hráčů: {}", requiredPlayers);
+  LOG_INFO("   - Max. počet místností: {}", maxLobbies);
+  LOG_INFO("   - Počet I/O vláken: {}", ioThreads);
+  LOG_INFO("   - Počet herních vláken: {}", gameThreads);
+  if (adminPort > 0) {
+      LOG_INFO("   - Admin port: {}", adminPort);
+  }
 }
 
 GameServer::~GameServer() {
-    std::cout << "🗑️ GameServer destruktor - provádím cleanup..." << std::endl;
+    LOG_INFO("🗑️ GameServer destruktor - provádím cleanup...");
     if (running) {
         stop();
     }
+    timerWheel->stop();
     cleanup();
 }
 
@@ -33,9 +65,25 @@ GameServer::~GameServer() {
 // ACCEPT CLIENTS - Přijímání nových klientů
 // ============================================================
 void GameServer::acceptClients() {
-    std::cout << "\n=== Čekám na připojení klientů ===" << std::endl;
+    LOG_INFO("\n=== Čekám na připojení klientů ===");
+
+    // Místnosti se vyřazují jen na tomto vlákně – nepotká se to s usazováním hráčů
+    auto lastReclaim = std::chrono::steady_clock::now();
 
     while (running) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReclaim >= LobbyManager::RECLAIM_INTERVAL) {
+            lobbyManager->reclaimIdle();
+            lastReclaim = now;
+        }
+
+        // Čekání s limitem, aby úklid místností běžel i bez nových připojení
+        pollfd listener{networkManager->getServerSocket(), POLLIN, 0};
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(LobbyManager::RECLAIM_INTERVAL);
+        if (poll(&listener, 1, static_cast<int>(timeout.count())) == 0) {
+            continue;
+        }
+
         sockaddr_in clientAddress{};
         socklen_t clientLen = sizeof(clientAddress);
 
@@ -43,7 +91,7 @@ void GameServer::acceptClients() {
             accept(networkManager->getServerSocket(), reinterpret_cast<sockaddr *>(&clientAddress), &clientLen);
         if (clientSocket < 0) {
             if (running) {
-                std::cerr << "Chyba při přijímání klienta" << std::endl;
+                LOG_ERROR("Chyba při přijímání klienta");
             }
             continue;
         }
@@ -53,99 +101,87 @@ void GameServer::acceptClients() {
         char clientIP[INET_ADDRSTRLEN];
         inet_ntop(AF_INET, &clientAddress.sin_addr, clientIP, INET_ADDRSTRLEN);
 
-        std::cout << "\n✓ Nový klient se připojil!" << std::endl;
-        std::cout << "  - Socket: " << clientSocket << std::endl;
-        std::cout << "  - IP: " << clientIP << std::endl;
-        std::cout << "  - Port: " << ntohs(clientAddress.sin_port) << std::endl;
+        LOG_INFO("\n✓ Nový klient se připojil!");
+        LOG_INFO("  - Socket: {}", clientSocket);
+        LOG_INFO("  - IP: {}", clientIP);
+        LOG_INFO("  - Port: {}", ntohs(clientAddress.sin_port));
 
         // Najdeme volnou místnost
         Lobby *lobby = lobbyManager->findAvailableLobby();
 
         if (!lobby) {
-            std::cout << "⚠ Všechny místnosti jsou plné, odmítám klienta" << std::endl;
+            LOG_WARN("⚠ Všechny místnosti jsou plné, odmítám klienta");
             networkManager->sendMessage(clientSocket, -1, Protocol::MessageType::DISCONNECT,
                                     {"Všechny místnosti jsou plné"});
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            close(clientSocket);
+            networkManager->closeSocketAfter(clientSocket);
             continue;
         }
-        std::cout << "  -> Přiřazuji do Lobby #" << lobby->id << std::endl;
+        LOG_INFO("  -> Přiřazuji do Lobby #{}", lobby->id);
 
         // Přidáme klienta do místnosti
         ClientInfo *client = lobby->clientManager->addClient(clientSocket, clientIP);
 
+        // Od teď socket obsluhují I/O vlákna reaktoru
+        if (!networkManager->registerClient(clientSocket, lobby, client)) {
+            lobby->clientManager->disconnectClient(client);
+            continue;
+        }
 
-        // Spuštění vlákna pro obsluhu klienta
-        client->clientThread = std::thread(&GameServer::handleClient, this, client, lobby);
-        client->clientThread.detach();
-
-        std::cout << "✓ Vlákno pro hráče #" << client->playerNumber << " (Lobby #"
-                    << lobby->id << ") spuštěno" << std::endl;
-
-        // Zobrazíme status
-        std::cout << lobbyManager->getLobbiesStatus();
-    }
-}
-
-// ============================================================
-// START GAME - Spuštění hry v samostatném vlákně
-// ============================================================
-void GameServer::startGame(Lobby *lobby) {
-    while (running) {
-        if (lobby->clientManager->getActiveCount() == requiredPlayers &&
-            lobby->clientManager->getauthorizeCount() == requiredPlayers && !lobby->gameStarted) {
-            std::cout << "\n🎮 Lobby #" << lobby->id << " - Všichni hráči připojeni!" << std::endl;
-
-
-            // ===== SPUŠTĚNÍ HRY =====
-            std::cout << "\n🚀 Lobby #" << lobby->id << " - SPOUŠTÍM HRU!"
-                    << std::endl;
-            lobby->gameManager->startGame();
-            lobby->gameStarted = true;
+        if (client->playerNumber != -1) {
+            // WELCOME zpráva
+            std::vector<std::string> welcomeData;
+            welcomeData.emplace_back(std::to_string(client->playerNumber));
+            welcomeData.emplace_back(std::to_string(lobby->id));
+            welcomeData.emplace_back(std::to_string(requiredPlayers));
 
-            // Zobrazíme status
-            std::cout << lobbyManager->getLobbiesStatus();
+            networkManager->sendMessage(client,
+                                       Protocol::MessageType::WELCOME, welcomeData);
         }
 
-        if (lobby->clientManager->getauthorizeCount() < requiredPlayers && lobby->gameStarted) {
-            lobby->gameStarted = false;
-            std::cout << "\n🚀 Lobby #" << lobby->id << " - Vypínám hru!" << std::endl;
-        }
+        LOG_INFO("✓ Hráč #{} (Lobby #{}) předán reaktoru", client->playerNumber, lobby->id);
 
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        // Doplnění místností, pokud volná místa klesla pod hranici
+        lobbyManager->ensureCapacity();
+
+        // Zobrazíme status
+        logLobbiesStatus(lobbyManager.get());
     }
 }
 
-std::optional<Protocol::Message>
-    GameServer::msgValidation(Lobby *lobby, ClientInfo *client, const std::string &recvMsg) {
+std::optional<Protocol::MessageView>
+    GameServer::msgValidation(Connection &conn, std::string_view recvMsg) {
+    Lobby* lobby = conn.lobby;
+    ClientInfo* client = conn.client;
 
     if (recvMsg.empty()) {
-        std::cout << "⚠ Hráč #" << client->playerNumber << " ztratil spojení" << std::endl;
-        if (lobby->gameStarted && client->playerNumber > -1) {
-            lobby->clientManager->handleClientDisconnection(client);
-        } else {
-            lobby->clientManager->disconnectClient(client);
-        }
+        // Ztrátu spojení zpracuje strand místnosti – stav hry i klienta patří jemu
+        lobby->strand->post([this, conn = conn.shared_from_this(), lobby, session = SessionHandle(client)] {
+            if (ClientInfo* client = session.get()) {
+                handleConnectionLost(conn, lobby, client);
+            } else {
+                networkManager->closeConnection(conn->socket, conn->generation);
+            }
+        });
         return std::nullopt;
     }
     if (!networkManager->isValidMessageString(recvMsg)) {
-        std::cerr << "❌ Hráč #" << client->playerNumber
-                  << " poslal neplatnou zprávu, odpojuji" << std::endl;
+        LOG_ERROR("❌ Hráč #{} poslal neplatnou zprávu, odpojuji", client->playerNumber);
 
-        networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT,
-                                {"Invalid message format"});
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        lobby->clientManager->disconnectClient(client);
+        metrics->recordValidationFailure(static_cast<int>(NetworkManager::ValidationResult::INVALID_CHARACTERS));
+        kickFromReactor(conn, {"Invalid message format"});
         return std::nullopt;
     }
 
-    Protocol::Message msg = Protocol::deserialize(recvMsg);
-
-    if (!networkManager->Validation(msg, client->playerNumber, requiredPlayers)) {
-        networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT,
-                                    {"Neplatná zpráva"});
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        lobby->clientManager->disconnectClient(client);
+    // Pole zprávy ukazují do přijímacího bufferu spojení – platí jen během zpracování rámce
+    Protocol::MessageView msg;
+    if (!Protocol::parse(recvMsg, msg)) {
+        metrics->recordValidationFailure(static_cast<int>(NetworkManager::ValidationResult::MALFORMED_DATA));
+        kickFromReactor(conn, {"Neplatná zpráva"});
+        return std::nullopt;
+    }
+    if (!networkManager->Validation(msg, client->playerNumber, requiredPlayers,
+                                    client->history.latestID())) {
+        kickFromReactor(conn, {"Neplatná zpráva"});
         return std::nullopt;
     }
 
@@ -153,223 +189,404 @@ std::optional<Protocol::Message>
 }
 
 // ============================================================
-// HANDLE CLIENT - Spuštění threadu pro klienta
+// KICK FROM REACTOR - Vyhození klienta z I/O vlákna
 // ============================================================
-void GameServer::handleClient(ClientInfo* client, Lobby* lobby) {
-    if (client->playerNumber != -1) {
-        std::cout << "\n>>> Vlákno pro hráče #" << client->playerNumber
-                  << " (Lobby #" << lobby->id << ") zahájeno <<<" << std::endl;
+void GameServer::kickFromReactor(Connection& conn, std::vector<std::string> reason) {
+    // I/O vlákno jen přestane číst; odpojení (STATUS, počty hráčů, uvolnění
+    // relace) provede strand místnosti, který může klienta právě obsluhovat
+    conn.muted = true;
+
+    Lobby* lobby = conn.lobby;
+    lobby->strand->post([lobby, session = SessionHandle(conn.client), reason = std::move(reason)] {
+        if (ClientInfo* client = session.get()) {
+            lobby->clientManager->kickClient(client, reason);
+        }
+    });
+}
 
-        // WELCOME zpráva
-        std::vector<std::string> welcomeData;
-        welcomeData.emplace_back(std::to_string(client->playerNumber));
-        welcomeData.emplace_back(std::to_string(lobby->id));
-        welcomeData.emplace_back(std::to_string(requiredPlayers));
+// ============================================================
+// HANDLE CONNECTION LOST - Ztráta spojení (na strandu místnosti)
+// ============================================================
+void GameServer::handleConnectionLost(const std::shared_ptr<Connection>& conn, Lobby* lobby, ClientInfo* client) {
+    // Klienta mezitím odpojil server (kick, timeout) nebo už obsluhuje jiné spojení –
+    // reaktor spojení drží, dokud ho neukončíme (socket klienta ho ukončil, pokud byl stejný)
+    if (!client->connected || client->socket != conn->socket) {
+        networkManager->closeConnection(conn->socket, conn->generation);
+        return;
+    }
 
-        networkManager->sendMessage(client->socket, client->playerNumber,
-                                   Protocol::MessageType::WELCOME, welcomeData);
+    LOG_WARN("⚠ Hráč #{} ztratil spojení", client->playerNumber);
+    if (lobby->gameStarted && client->playerNumber > -1) {
+        lobby->clientManager->handleClientDisconnection(client);
+    } else {
+        lobby->clientManager->disconnectClient(client);
     }
+}
 
-    // Čekání na CONNECT nebo RECONNECT
-    std::string recvMsg = networkManager->receiveMessage(client->socket);
-    auto msgOpt = msgValidation(lobby, client, recvMsg);
-    if (!msgOpt.has_value()) {
+// ============================================================
+// ON CLIENT FRAME - Zpracování rámce přijatého reaktorem
+// ============================================================
+void GameServer::onClientFrame(Connection& conn, std::string_view recvMsg) {
+    // Během handshaku spojení patří strandu místnosti
+    Connection::Handshake phase = conn.handshake.load(std::memory_order_acquire);
+    if (phase == Connection::Handshake::PENDING) {
+        if (!recvMsg.empty()) {
+            // Klient má čekat na AUTHORIZE/RECONNECT – dřívější zprávy (PING) zahodíme
+            LOG_WARN("⚠ Zpráva během handshaku na socketu {} zahozena", conn.socket);
+            return;
+        }
+
+        // Odpojení převezme dokončení handshaku; pokud už doběhl, odpojíme klienta sami
+        if (conn.handshake.compare_exchange_strong(phase, Connection::Handshake::LOST,
+                                                   std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    Lobby* lobby = conn.lobby;
+    ClientInfo* client = conn.client;
+
+    // Relace spojení už byla odpojena a její slot recyklován – rámec nepatří nikomu
+    if (client->generation != conn.clientGeneration) {
+        if (recvMsg.empty()) {
+            networkManager->closeConnection(conn.socket, conn.generation);
+        }
         return;
     }
 
-    Protocol::Message msg = *msgOpt;
+    // Klienta už odpojuje strand – zbytek dat zahodíme, ztrátu spojení ale předáme
+    if (conn.muted && !recvMsg.empty()) {
+        return;
+    }
 
-    if (msg.type != Protocol::MessageType::CONNECT &&
-        msg.type != Protocol::MessageType::RECONNECT) {
-        std::cerr << "⚠ Hráč #" << client->playerNumber
-                  << " poslal nesprávný msgType" << std::endl;
-        networkManager->sendMessage(client->socket, client->playerNumber,
-                                   Protocol::MessageType::DISCONNECT,
-                                   {"Nesprávný msgType"});
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        lobby->clientManager->disconnectClient(client);
+    auto msgOpt = msgValidation(conn, recvMsg);
+    if (!msgOpt.has_value()) {
         return;
     }
 
-    std::string nickname = msg.fields[0];
+    const Protocol::MessageView& msg = *msgOpt;
+    metrics->recordInbound(msg.type, recvMsg.size());
+
+    // CONNECT nebo RECONNECT zpracuje strand místnosti (přezdívky, autorizace
+    // a reconnect se tak nepotkají s ostatními zprávami místnosti)
+    if (phase == Connection::Handshake::NONE) {
+        conn.handshake.store(Connection::Handshake::PENDING, std::memory_order_relaxed);
+        lobby->strand->post([this, conn = conn.shared_from_this(), lobby,
+                             session = SessionHandle(client), message = msg.toMessage()] {
+            handleHandshake(conn, lobby, session, message);
+        });
+        return;
+    }
 
-    // === RECONNECT HANDLING ===
-    if (msg.type == Protocol::MessageType::RECONNECT && !nickname.empty()) {
-        std::cout << "🔄 Pokus o reconnect se session ID: " << nickname << std::endl;
+    if (!running || !client->connected) {
+        return;
+    }
 
-        ClientInfo* oldClient = lobby->clientManager->findDisconnectedClient(nickname);
+    // Aktualizace last seen
+    client->lastSeen = std::chrono::steady_clock::now();
 
-        if (oldClient && lobby->clientManager->reconnectClient(oldClient, client->socket)) {
-            std::cout << "✅ Hráč #" << oldClient->playerNumber << " úspěšně reconnectnut" << std::endl;
+    // Herní zprávy zpracuje strand místnosti – I/O vlákno zprávu jen vloží do
+    // lock-free schránky a hned pokračuje ve čtení. Pohled do přijímacího bufferu
+    // platí jen teď, do schránky jde vlastnící kopie.
+    bool queued = lobby->strand->tryPost([this, lobby, session = SessionHandle(client), message = msg.toMessage()] {
+        // Klient se mohl mezitím odpojit (slot relace už může patřit jinému)
+        ClientInfo* client = session.get();
+        if (!running || !client || !client->connected) {
+            return;
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        try {
+            lobby->messageHandler->processClientMessage(client, message);
+        } catch (const std::exception &e) {
+            LOG_ERROR("❌ Výjimka při zpracování: {}", e.what());
+            lobby->clientManager->kickClient(client, {"Internal server error"});
+        }
+        metrics->recordHandlerLatency(message.type, std::chrono::steady_clock::now() - started);
+    });
 
-            client = oldClient;
+    // Plná schránka = místnost nestíhá; hráče, který ji zahlcuje, odpojíme
+    if (!queued) {
+        LOG_WARN("⚠ Schránka Lobby #{} je plná ({}) - odpojuji hráče #{}", lobby->id, lobby->strand->getDepth(), client->playerNumber);
+        kickFromReactor(conn, {"Server je přetížen"});
+    }
+}
 
-            // Pošleme znovupotvrzení packety
-            int packetID = std::atoi(msg.fields[1].c_str());
-            lobby->clientManager->sendLossPackets(oldClient, packetID);
+// ============================================================
+// HANDLE HANDSHAKE - CONNECT / RECONNECT nového spojení (na strandu místnosti)
+// ============================================================
+void GameServer::handleHandshake(const std::shared_ptr<Connection>& conn, Lobby* lobby,
+                                 SessionHandle session, const Protocol::Message& msg) {
+    ClientInfo* client = session.get();
+    if (!client || !client->connected) {
+        return;
+    }
 
-            // Potvrdíme reconnect
-            networkManager->sendMessage(client->socket, client->playerNumber,
-                                       Protocol::MessageType::RECONNECT, {});
+    if ((msg.type != Protocol::MessageType::CONNECT &&
+         msg.type != Protocol::MessageType::RECONNECT) || msg.fields.empty()) {
+        LOG_WARN("⚠ Hráč #{} poslal nesprávný msgType", client->playerNumber);
+        lobby->clientManager->kickClient(client, {"Nesprávný msgType"});
+        return;
+    }
 
-            // 🆕 SKIP AUTHORIZE - klient už je autorizován!
-            std::cout << "  -> Přeskakuji autorizaci (reconnect)" << std::endl;
+    const std::string& nickname = msg.fields[0];
 
+    // === RECONNECT HANDLING ===
+    if (msg.type == Protocol::MessageType::RECONNECT && !nickname.empty()) {
+        LOG_INFO("🔄 Pokus o reconnect se session ID: {}", nickname);
+
+        // Token relace najde původní místnost a místo v celém serveru (O(1));
+        // starší klienti posílají přezdívku a hledá se jen v přidělené místnosti
+        ClientInfo* oldClient = nullptr;
+        Lobby* origin = lobby;
+        SessionPool::Resumable resumable = sessionPool->findByToken(nickname);
+        if (resumable.client) {
+            oldClient = resumable.client;
+            origin = resumable.lobby;
         } else {
-            std::cerr << "❌ Reconnect selhal" << std::endl;
-            networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT,
-                                        {"Reconnect selhal - relace je neplatná nebo vypršela"});
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            lobby->clientManager->disconnectClient(client);
+            oldClient = lobby->clientManager->findDisconnectedClient(nickname);
+        }
+
+        // Poslední ID, které klient z původní řady přijal (0 = nic)
+        uint32_t packetID = 0;
+        if (msg.fields.size() > 1 && !Protocol::parseNumber(msg.fields[1], packetID)) {
+            packetID = 0;
+        }
+
+        if (!oldClient) {
+            LOG_ERROR("❌ Reconnect selhal");
+            metrics->recordReconnect(false);
+            lobby->clientManager->kickClient(client, {"Reconnect selhal - relace je neplatná nebo vypršela"});
             return;
         }
+
+        if (origin != lobby) {
+            // Původní relaci obnoví strand její místnosti; dočasný klient zatím
+            // zůstává zde (bez časovačů) a odebere ho až výsledek reconnectu
+            LOG_INFO("  -> Relace patří do Lobby #{}, přesouvám spojení", origin->id);
+            lobby->clientManager->holdClient(client);
+            origin->strand->post([this, conn, lobby, session, origin, resumed = SessionHandle(oldClient), packetID] {
+                resumeSession(conn, lobby, session, origin, resumed, packetID);
+            });
+        } else {
+            resumeSession(conn, lobby, session, origin, SessionHandle(oldClient), packetID);
+        }
+        return;
     }
+
     // === NORMÁLNÍ CONNECT ===
-    else {
-        client->nickname = nickname;
-        std::cout << "  -> Nickname přijat od hráče #" << client->playerNumber << std::endl;
-
-        bool sameNickname = false;
-        for (auto c : lobby->clientManager->getClients()) {
-            if (c->nickname == nickname && c->playerNumber != client->playerNumber) {
-                sameNickname = true;
-            }
+    client->nickname = nickname;
+    LOG_INFO("  -> Nickname přijat od hráče #{}", client->playerNumber);
+
+    // Volitelné schopnosti klienta za přezdívkou
+    for (size_t i = 1; i < msg.fields.size(); i++) {
+        if (msg.fields[i] == Protocol::CAPABILITY_DELTA_STATE) {
+            client->deltaState = true;
+            LOG_INFO("  -> Hráč #{} přijímá STATE_DELTA", client->playerNumber);
         }
+    }
 
-        if (!sameNickname) {
-            networkManager->sendMessage(client->socket, client->playerNumber,
-                                       Protocol::MessageType::AUTHORIZE, {});
-            std::cout << "  -> AUTHORIZE odesláno hráči #" << client->playerNumber << std::endl;
-            client->approved = true;
-
-            std::cout << "  -> Hráč #" << client->playerNumber << " byl autorizován" << std::endl;
-            lobby->clientManager->setauthorizeCount();
-
-            if (lobby->clientManager->getauthorizeCount() < requiredPlayers) {
-                networkManager->sendMessage(
-                    client->socket, client->playerNumber,
-                    Protocol::MessageType::WAIT_LOBBY,
-                    {std::to_string(lobby->clientManager->getauthorizeCount())});
-                std::cout << "  -> WAIT_LOBBY odesláno hráči #" << client->playerNumber << std::endl;
+    bool sameNickname = false;
+    for (auto c : lobby->clientManager->getClients()) {
+        if (c->nickname == nickname && c->playerNumber != client->playerNumber) {
+            sameNickname = true;
+        }
+    }
+
+    if (sameNickname) {
+        LOG_ERROR("❌ Chyba: Stejné jméno!");
+        lobby->clientManager->kickClient(client, {"Chyba: Stejné jméno!"});
+        return;
+    }
+
+    // Spojení předáme dřív, než klient dostane odpověď (hned na ni reaguje)
+    if (!finishHandshake(conn, lobby, client)) {
+        return;
+    }
+
+    // Token pro případný reconnect – platí, dokud relace žije
+    std::string token = sessionPool->issueToken(session, lobby);
+    if (token.empty()) {
+        return;
+    }
+    networkManager->sendMessage(client,
+                               Protocol::MessageType::AUTHORIZE, {token});
+    LOG_INFO("  -> AUTHORIZE odesláno hráči #{}", client->playerNumber);
+    lobby->clientManager->authorizeClient(client);
+
+    LOG_INFO("  -> Hráč #{} byl autorizován", client->playerNumber);
+    lobby->clientManager->setauthorizeCount();
+
+    if (lobby->clientManager->getauthorizeCount() < requiredPlayers) {
+        networkManager->sendMessage(
+            client,
+            Protocol::MessageType::WAIT_LOBBY,
+            {std::to_string(lobby->clientManager->getauthorizeCount())});
+        LOG_INFO("  -> WAIT_LOBBY odesláno hráči #{}", client->playerNumber);
+    }
+
+    // Autorizace posledního hráče hned spustí hru
+    lobby->clientManager->notifyReadiness();
+}
+
+// ============================================================
+// RESUME SESSION - Obnovení relace (na strandu její místnosti)
+// ============================================================
+void GameServer::resumeSession(const std::shared_ptr<Connection>& conn, Lobby* lobby, SessionHandle session,
+                               Lobby* origin, SessionHandle resumed, uint32_t packetID) {
+    ClientInfo* client = session.get();
+    if (!client || !client->connected) {
+        return;
+    }
+
+    // Lhůta na reconnect mohla mezitím vypršet
+    ClientInfo* oldClient = resumed.get();
+    if (!oldClient || !origin->clientManager->canResume(oldClient)) {
+        LOG_ERROR("❌ Reconnect selhal");
+        metrics->recordReconnect(false);
+
+        // Dočasného klienta vyhodí jeho vlastní místnost
+        auto kick = [lobby, session] {
+            if (ClientInfo* client = session.get()) {
+                lobby->clientManager->kickClient(client, {"Reconnect selhal - relace je neplatná nebo vypršela"});
             }
+        };
+        if (origin != lobby) {
+            lobby->strand->post(kick);
         } else {
-            std::cerr << "❌ Chyba: Stejné jméno!" << std::endl;
-            networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT,
-                                       {"Chyba: Stejné jméno!"});
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            lobby->clientManager->disconnectClient(client);
-            return;
+            kick();
         }
+        return;
     }
 
-    // === HLAVNÍ SMYČKA ===
-    std::cout << "  -> Vstupuji do příjmací smyčky pro hráče #" << client->playerNumber << std::endl;
-    MessageHandler handler(networkManager.get(), lobby->clientManager.get(),
-                          lobby->gameManager.get());
+    // Dočasný klient uvolní místo v přidělené místnosti (na jejím strandu),
+    // spojení od teď patří původní
+    if (origin != lobby) {
+        lobby->strand->post([lobby, session] {
+            if (ClientInfo* client = session.get()) {
+                lobby->clientManager->detachClient(client);
+            }
+        });
+    }
 
-    while (running && client->connected) {
-        recvMsg = networkManager->receiveMessage(client->socket);
-        msgOpt = msgValidation(lobby, client, recvMsg);
-        if (!msgOpt.has_value()) {
-            break;
-        }
-        msg = *msgOpt;
+    origin->clientManager->reconnectClient(oldClient, conn->socket);
+    LOG_INFO("✅ Hráč #{} úspěšně reconnectnut", oldClient->playerNumber);
+    metrics->recordReconnect(true);
 
-        // Aktualizace last seen
-        client->lastSeen = std::chrono::steady_clock::now();
+    if (!finishHandshake(conn, origin, oldClient)) {
+        return;
+    }
 
-        try {
-            handler.processClientMessage(client, msg);
-        } catch (const std::exception &e) {
-            std::cerr << "❌ Výjimka při zpracování: " << e.what() << std::endl;
-            networkManager->sendMessage(client->socket, client->playerNumber, Protocol::MessageType::DISCONNECT,
-                                       {"Internal server error"});
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            break;
-        }
+    // Pošleme znovupotvrzení packety
+    origin->clientManager->sendLossPackets(oldClient, packetID);
+
+    // Potvrdíme reconnect
+    networkManager->sendMessage(oldClient,
+                               Protocol::MessageType::RECONNECT, {});
+
+    // Delta klient dostane plný snímek – na jeho verzi stavu už nenavazujeme
+    if (oldClient->deltaState && origin->gameStarted) {
+        origin->gameManager->sendGameStateToPlayer(oldClient->playerNumber);
+    }
+
+    // 🆕 SKIP AUTHORIZE - klient už je autorizován!
+    LOG_INFO("  -> Přeskakuji autorizaci (reconnect)");
+}
+
+// ============================================================
+// FINISH HANDSHAKE - Předání spojení zpět I/O vláknům
+// ============================================================
+bool GameServer::finishHandshake(const std::shared_ptr<Connection>& conn, Lobby* lobby, ClientInfo* client) {
+    conn->lobby = lobby;
+    conn->client = client;
+    conn->clientGeneration = client->generation;
+
+    Connection::Handshake phase = Connection::Handshake::PENDING;
+    if (!conn->handshake.compare_exchange_strong(phase, Connection::Handshake::DONE,
+                                                 std::memory_order_acq_rel)) {
+        // Spojení spadlo během handshaku – I/O vlákno odpojení nechalo na nás
+        handleConnectionLost(conn, lobby, client);
+        return false;
     }
 
-    std::cout << "\n<<< Vlákno pro hráče #" << client->playerNumber << " (Lobby #"
-              << lobby->id << ") končí >>>" << std::endl;
+    LOG_INFO("  -> Hráč #{} (Lobby #{}) přechází do příjmací smyčky", client->playerNumber, lobby->id);
+    return true;
 }
 
 // ============================================================
 // HLAVNÍ METODY - START, STOP
 // ============================================================
 void GameServer::start() {
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "🚀 SPOUŠTÍM SERVER" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    LOG_INFO("\n{}", std::string(60, '='));
+    LOG_INFO("🚀 SPOUŠTÍM SERVER");
+    LOG_INFO("{}", std::string(60, '='));
 
     // Inicializace socketu
     if (!networkManager->initializeSocket()) {
-        std::cerr << "❌ Nepodařilo se inicializovat socket" << std::endl;
+        LOG_ERROR("❌ Nepodařilo se inicializovat socket");
         return;
     }
 
     // Vytvoření místností (musí být až po inicializaci socketu)
-    lobbyManager = std::make_unique<LobbyManager>(networkManager.get(),
-                                                requiredPlayers, lobbyCount);
+    lobbyManager = std::make_unique<LobbyManager>(networkManager.get(), timerWheel.get(),
+                                                workerPool.get(), sessionPool.get(), metrics.get(),
+                                                requiredPlayers, maxLobbies);
+
+    // Admin rozhraní čte souhrny místností – spouští se až s nimi
+    if (adminPort > 0) {
+        adminServer = std::make_unique<AdminServer>(adminPort, lobbyManager.get(), sessionPool.get(),
+                                                    metrics.get());
+        if (!adminServer->start()) {
+            adminServer.reset();
+        }
+    }
 
     running = true;
 
-    // Spuštění vláken pro každou lobby
-    for (int i = 1; i <= lobbyCount; i++) {
-        Lobby *lobby = lobbyManager->getLobby(i);
-        if (lobby) {
-            std::thread gameThread(&GameServer::startGame, this, lobby);
-            gameThread.detach();
-            std::cout << "🎲 Spuštěno game-thread pro Lobby #" << lobby->id
-                    << std::endl;
-        }
+    // Herní vlákna musí běžet dřív, než reaktor začne plnit strandy místností
+    workerPool->start();
+
+    // Spuštění reaktoru – pevný počet I/O vláken pro všechny klienty
+    if (!networkManager->startReactor(ioThreads, [this](Connection &conn, std::string_view recvMsg) {
+            onClientFrame(conn, recvMsg);
+        })) {
+        LOG_ERROR("❌ Nepodařilo se spustit reaktor");
+        running = false;
+        return;
     }
 
     // Spuštění accept threadu
-    std::cout << "\n🔄 Spouštím accept thread..." << std::endl;
+    LOG_INFO("\n🔄 Spouštím accept thread...");
     acceptThread = std::thread(&GameServer::acceptClients, this);
 
-    // Spuštění timeout checkeru pro všechny místnosti
-    std::thread timeoutThread([this]() {
-    std::cout << "🕒 Spouštím timeout checker..." << std::endl;
-
-    while (running) {
-        for (int i = 1; i <= lobbyCount; i++) {
-            Lobby *lobby = lobbyManager->getLobby(i);
-            if (lobby && lobby->clientManager) {
-                lobby->clientManager->checkDisconnectedClients(running);
-            }
-        }
-
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-    }
-
-    std::cout << "🛑 Timeout checker zastaven" << std::endl;
-    });
-    timeoutThread.detach();
+    // Spuštění časového kola pro timeouty klientů ve všech místnostech
+    timerWheel->start();
 
-    std::cout << "\n✅ Server úspěšně spuštěn!" << std::endl;
-    std::cout << "📡 Naslouchám na portu " << port << std::endl;
-    std::cout << "🏠 Počet místností: " << lobbyCount << std::endl;
-    std::cout << "⏳ Každá místnost čeká na " << requiredPlayers << " hráče..."
-            << std::endl;
-    std::cout << lobbyManager->getLobbiesStatus();
-    std::cout << std::string(60, '=') << std::endl;
+    LOG_INFO("\n✅ Server úspěšně spuštěn!");
+    LOG_INFO("📡 Naslouchám na portu {}", port);
+    LOG_INFO("🏠 Počet místností: {} (limit {})", lobbyManager->getLobbyCount(), maxLobbies);
+    LOG_INFO("⏳ Každá místnost čeká na {} hráče...", requiredPlayers);
+    logLobbiesStatus(lobbyManager.get());
+    LOG_INFO("{}", std::string(60, '='));
 
     // Čekáme na dokončení accept threadu (blocking)
     if (acceptThread.joinable()) {
         acceptThread.join();
     }
 
-    std::cout << "\n🛑 Server ukončen" << std::endl;
+    LOG_INFO("\n🛑 Server ukončen");
 }
 
 void GameServer::stop() {
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "🛑 ZASTAVUJI SERVER" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    LOG_INFO("\n{}", std::string(60, '='));
+    LOG_INFO("🛑 ZASTAVUJI SERVER");
+    LOG_INFO("{}", std::string(60, '='));
 
     running = false;
 
+    // Žádné další timeouty – klienty odpojujeme sami
+    timerWheel->stop();
+
     // Zavření hlavního socketu (ukončí accept loop)
     networkManager->closeServerSocket();
 
@@ -380,12 +597,22 @@ void GameServer::stop() {
 
     // Počkáme na dokončení accept threadu
     if (acceptThread.joinable()) {
-        std::cout << "⏳ Čekám na dokončení accept threadu..." << std::endl;
+        LOG_INFO("⏳ Čekám na dokončení accept threadu...");
         acceptThread.join();
     }
 
-    std::cout << "✅ Server zastaven" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    // Zastavení I/O vláken
+    networkManager->stopReactor();
+
+    if (adminServer) {
+        adminServer->stop();
+    }
+
+    // Zastavení herních vláken (strandy místností už nic nezpracují)
+    workerPool->stop();
+
+    LOG_INFO("✅ Server zastaven");
+    LOG_INFO("{}", std::string(60, '='));
 }
 
 bool GameServer::isRunning() const { return running; }
@@ -401,7 +628,16 @@ std::string GameServer::getStatus() const {
 // CLEANUP - Úklid zdrojů
 // ============================================================
 void GameServer::cleanup() {
-    std::cout << "🧹 Provádím cleanup..." << std::endl;
+    LOG_INFO("🧹 Provádím cleanup...");
+
+    // Místnosti se ruší až bez běžících strandů a bez čtení admin rozhraní
+    if (workerPool) {
+        workerPool->stop();
+    }
+
+    if (adminServer) {
+        adminServer.reset();
+    }
 
     if (lobbyManager) {
         lobbyManager.reset();
@@ -411,5 +647,5 @@ void GameServer::cleanup() {
         networkManager.reset();
     }
 
-    std::cout << "✅ Cleanup dokončen" << std::endl;
+    LOG_INFO("✅ Cleanup dokončen");
 }
\ No newline at end of file
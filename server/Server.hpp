@@ -1,10 +1,15 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include "AdminServer.hpp"
 #include "ClientManager.hpp"
 #include "LobbyManager.hpp"
 #include "MessageHandler.hpp"
+#include "Metrics.hpp"
 #include "NetworkManager.hpp"
+#include "SessionPool.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
 #include <atomic>
 #include <memory>
 #include <optional>
@@ -13,24 +18,40 @@
 
 class GameServer {
 private:
+  std::unique_ptr<Metrics> metrics;       // Čítače a histogramy (musí přežít všechny zapisující)
+  std::unique_ptr<TimerWheel> timerWheel; // Časovače timeoutů a odložených zavření
   std::unique_ptr<NetworkManager> networkManager;
+  std::unique_ptr<WorkerPool> workerPool; // Herní vlákna sdílená strandy všech místností
+  std::unique_ptr<SessionPool> sessionPool; // Sloty relací klientů (musí přežít místnosti)
   std::unique_ptr<LobbyManager> lobbyManager;
   std::unique_ptr<MessageHandler> messageHandler;
+  std::unique_ptr<AdminServer> adminServer; // Admin rozhraní (jen s -a)
 
   std::string ip;            // IP adresa
   int port;                  // Port
   std::atomic<bool> running; // Příznak běhu serveru
   int requiredPlayers;       // Požadovaný počet hráčů
-  int lobbyCount;            // Počet lobby
+  int maxLobbies;            // Horní mez počtu lobby (vytváří se podle potřeby)
+  int ioThreads;             // Počet I/O vláken reaktoru
+  int gameThreads;           // Počet herních vláken
+  int adminPort;             // Port admin rozhraní na loopbacku (0 = vypnuto)
   std::thread acceptThread;  // Vlákno pro připojení klientů
-  void startGame(Lobby *lobby);
   void acceptClients();
-  void handleClient(ClientInfo *client, Lobby *lobby);
+  void onClientFrame(Connection &conn, std::string_view recvMsg);
+  // Handshake a odpojení běží na strandu místnosti – I/O vlákno stav klienta nemění
+  void handleHandshake(const std::shared_ptr<Connection> &conn, Lobby *lobby,
+                       SessionHandle session, const Protocol::Message &msg);
+  void resumeSession(const std::shared_ptr<Connection> &conn, Lobby *lobby, SessionHandle session,
+                     Lobby *origin, SessionHandle resumed, uint32_t packetID);
+  bool finishHandshake(const std::shared_ptr<Connection> &conn, Lobby *lobby, ClientInfo *client);
+  void kickFromReactor(Connection &conn, std::vector<std::string> reason);
+  void handleConnectionLost(const std::shared_ptr<Connection> &conn, Lobby *lobby, ClientInfo *client);
   void cleanup();
 
 public:
   // 🆕 Konstruktor s IP adresou
-  GameServer(const std::string &ip, int port, int requiredPlayers, int lobbies);
+  GameServer(const std::string &ip, int port, int requiredPlayers, int maxLobbies,
+             int ioThreads, int gameThreads, int adminPort);
   ~GameServer();
 
   void start();
@@ -38,8 +59,8 @@ public:
   bool isRunning() const;
   std::string getStatus() const;
 
-  std::optional<Protocol::Message>
-  msgValidation(Lobby *lobby, ClientInfo *client, const std::string &recvMsg);
+  std::optional<Protocol::MessageView>
+  msgValidation(Connection &conn, std::string_view recvMsg);
 };
 
 #endif // SERVER_HPP
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "SessionPool.hpp"
+#include "Logger.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <random>
+
+SessionPool::SessionPool(size_t reserve) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (freeSlots.size() < reserve) {
+        grow();
+    }
+    LOG_INFO("🗃️ Pool relací připraven ({} slotů)", freeSlots.size());
+}
+
+SessionPool::~SessionPool() {
+    if (inUse > 0) {
+        LOG_WARN("⚠ Pool relací ruší {} nevrácených relací", inUse.load());
+    }
+}
+
+void SessionPool::grow() {
+    blocks.push_back(std::make_unique<ClientInfo[]>(BLOCK_SIZE));
+    ClientInfo* block = blocks.back().get();
+    capacity += BLOCK_SIZE;
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        freeSlots.push_back(&block[i]);
+    }
+}
+
+ClientInfo* SessionPool::acquire(int socket, int playerNumber, const std::string& address) {
+    ClientInfo* client;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSlots.empty()) {
+            grow();
+        }
+        client = freeSlots.front();
+        freeSlots.pop_front();
+        inUse++;
+    }
+
+    // Výchozí stav relace – texty si ponechají kapacitu z minulého použití
+    auto now = std::chrono::steady_clock::now();
+    client->socket = socket;
+    client->playerNumber = playerNumber;
+    client->connected = true;
+    client->isDisconnected = false;
+    client->approved = false;
+    client->deltaState = false;
+    client->stateVersion = 0;
+    client->lastSeen = now;
+    client->createdAt = now;
+    client->welcomeTimer = 0;
+    client->reconnectTimer = 0;
+    client->idleTimer = 0;
+    client->address.assign(address);
+    client->nickname.clear();
+    client->history.reset();
+    return client;
+}
+
+void SessionPool::release(ClientInfo* client) {
+    if (!client) return;
+
+    // Od teď všechny handly na tuto relaci vrací nullptr
+    client->generation++;
+    client->connected = false;
+    client->socket = -1;
+
+    revokeToken(client);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    freeSlots.push_back(client);
+    inUse--;
+}
+
+// ============================================================
+// TOKENY RELACÍ
+// ============================================================
+std::string SessionPool::issueToken(const SessionHandle& session, Lobby* lobby) {
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    // Uvolněný (a možná recyklovaný) slot token nedostane
+    ClientInfo* client = session.get();
+    if (!client) {
+        return {};
+    }
+
+    // Náhodný token z generátoru OS – nelze ho odvodit z přezdívky ani čísla hráče.
+    // Zařízení se otevře jednou na vlákno, ne při každém handshaku.
+    thread_local std::random_device random;
+    std::string token;
+    token.reserve(TOKEN_BYTES * 2);
+    for (size_t i = 0; i < TOKEN_BYTES; i += 4) {
+        uint32_t value = random();
+        for (int byte = 0; byte < 4; byte++) {
+            token += HEX[(value >> 4) & 0xF];
+            token += HEX[value & 0xF];
+            value >>= 8;
+        }
+    }
+
+    // Relace má vždy nejvýše jeden platný token
+    revokeToken(client);
+    client->sessionToken = token;
+
+    TokenShard& shard = shardFor(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries[token] = TokenEntry{session, lobby}; // Generace volajícího – po recyklaci slotu záznam neplatí
+    return token;
+}
+
+SessionPool::Resumable SessionPool::findByToken(std::string_view token) {
+    if (token.size() != TOKEN_BYTES * 2) {
+        return {};
+    }
+
+    TokenShard& shard = shardFor(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(std::string(token));
+    if (it == shard.entries.end()) {
+        return {};
+    }
+
+    ClientInfo* client = it->second.session.get();
+    if (!client) {
+        shard.entries.erase(it); // Relace mezitím skončila
+        return {};
+    }
+    return {client, it->second.lobby};
+}
+
+void SessionPool::revokeToken(ClientInfo* client) {
+    if (client->sessionToken.empty()) {
+        return;
+    }
+
+    TokenShard& shard = shardFor(client->sessionToken);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.erase(client->sessionToken);
+    }
+    client->sessionToken.clear();
+}
+
+SessionPool::TokenShard& SessionPool::shardFor(std::string_view token) {
+    return tokenShards[std::hash<std::string_view>{}(token) % TOKEN_SHARDS];
+}
+
+size_t SessionPool::getCapacity() const {
+    return capacity.load(std::memory_order_relaxed);
+}
+
+size_t SessionPool::getInUse() const {
+    return inUse.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,79 @@
+#ifndef SESSION_POOL_HPP
+#define SESSION_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ClientManager.hpp"
+
+struct Lobby;
+
+// Zásobník relací klientů pro celý server.
+// Relace se alokují po blocích pevné velikosti a nikdy se neuvolňují – odpojený
+// klient vrátí slot do fronty volných a další připojení ho znovu použije
+// (včetně kapacity textů a historie paketů). Uvolnění zvýší generaci slotu,
+// takže staré SessionHandle relaci poznají jako neplatnou. Volné sloty se
+// přidělují od nejdéle volného, aby se čerstvě uvolněný slot hned nerecykloval.
+//
+// Autorizovaná relace dostane náhodný token. Index tokenů je společný pro celý
+// server (rozdělený na shardy s vlastním zámkem), takže RECONNECT najde relaci
+// i její místnost v O(1) bez ohledu na to, kam bylo nové spojení přiřazeno.
+// Token uložený v relaci (sessionToken) mění jen strand její místnosti –
+// vydání tokenu (handshake) i uvolnění relace (odpojení) běží tam.
+class SessionPool {
+public:
+    static constexpr size_t BLOCK_SIZE = 64; // Počet relací v jednom bloku
+
+    // Relace nalezená podle tokenu a místnost, ve které sedí
+    struct Resumable {
+        ClientInfo* client = nullptr;
+        Lobby* lobby = nullptr;
+    };
+
+    explicit SessionPool(size_t reserve); // Předalokuje alespoň reserve slotů
+    ~SessionPool();
+
+    ClientInfo* acquire(int socket, int playerNumber, const std::string& address); // Vrátí čistou relaci
+    void release(ClientInfo* client); // Vrátí relaci do poolu a zneplatní její handly (i token)
+
+    std::string issueToken(const SessionHandle& session, Lobby* lobby); // Vydá relaci token a zapíše ho do indexu (prázdný = relace skončila)
+    Resumable findByToken(std::string_view token); // Relace podle tokenu (client = nullptr, pokud neplatí)
+
+    // Gettery (bez zámku)
+    size_t getCapacity() const;
+    size_t getInUse() const;
+
+private:
+    std::mutex mutex;                                 // Zámek bloků a volných slotů
+    std::vector<std::unique_ptr<ClientInfo[]>> blocks; // Bloky slotů (adresy se nemění)
+    std::deque<ClientInfo*> freeSlots;               // Volné sloty (FIFO)
+    std::atomic<size_t> inUse{0};                    // Počet přidělených relací
+    std::atomic<size_t> capacity{0};                 // Počet slotů ve všech blocích
+
+    static constexpr size_t TOKEN_SHARDS = 16;  // Počet shardů indexu tokenů
+    static constexpr size_t TOKEN_BYTES = 16;   // Délka tokenu v bajtech (hex = dvojnásobek znaků)
+
+    struct TokenEntry {
+        SessionHandle session; // Relace (generace odhalí recyklovaný slot)
+        Lobby* lobby;          // Místnost relace
+    };
+    struct TokenShard {
+        std::mutex mutex;
+        std::unordered_map<std::string, TokenEntry> entries;
+    };
+    std::array<TokenShard, TOKEN_SHARDS> tokenShards; // Index tokenů
+
+    void grow(); // Přidá další blok (vyžaduje mutex)
+    TokenShard& shardFor(std::string_view token);
+    void revokeToken(ClientInfo* client); // Odebere token relace z indexu
+};
+
+#endif // SESSION_POOL_HPP
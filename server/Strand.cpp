@@ -0,0 +1,141 @@
+#include "Strand.hpp"
+#include "WorkerPool.hpp"
+#include "Logger.hpp"
+
+
+Strand::Strand(WorkerPool* pool)
+    : pool(pool), inbox(INBOX_CAPACITY), overflowSize(0), scheduled(false), draining(0), peakDepth(0), rejected(0) {}
+
+// ============================================================
+// ZAŘAZENÍ ÚLOH
+// ============================================================
+bool Strand::tryPost(Task task) {
+    // Čeká-li něco v rezervě, zpráva se zařadí až za to – jinak by rezervu předběhla
+    Spill spilled = spill(task, INBOX_CAPACITY);
+    if (spilled == Spill::FULL || (spilled == Spill::EMPTY && !inbox.tryPush(std::move(task)))) {
+        rejected++;
+        return false;
+    }
+
+    recordDepth();
+    schedule();
+    return true;
+}
+
+void Strand::post(Task task) {
+    if (spill(task, SIZE_MAX) == Spill::EMPTY && !inbox.tryPush(std::move(task))) {
+        // Jen při přetížení – od teď jde vše do rezervy, dokud se nevyprázdní
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back(std::move(task));
+        overflowSize++;
+    }
+
+    recordDepth();
+    schedule();
+}
+
+Strand::Spill Strand::spill(Task& task, size_t limit) {
+    if (overflowSize.load() == 0) {
+        return Spill::EMPTY;
+    }
+
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    if (overflow.empty()) {
+        return Spill::EMPTY;
+    }
+    if (overflow.size() >= limit) {
+        return Spill::FULL;
+    }
+    overflow.push_back(std::move(task));
+    overflowSize++;
+    return Spill::QUEUED;
+}
+
+void Strand::schedule() {
+    // Dávku zařadí jen první producent – ostatní úlohy zpracuje ona
+    if (!scheduled.exchange(true)) {
+        pool->submit([this] { drain(); });
+    }
+}
+
+void Strand::recordDepth() {
+    size_t depth = getDepth();
+    size_t peak = peakDepth.load(std::memory_order_relaxed);
+    while (depth > peak && !peakDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+    }
+}
+
+// ============================================================
+// ZPRACOVÁNÍ
+// ============================================================
+bool Strand::next(Task& task) {
+    if (inbox.tryPop(task)) {
+        return true;
+    }
+    if (overflowSize == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    if (overflow.empty()) {
+        return false;
+    }
+    task = std::move(overflow.front());
+    overflow.pop_front();
+    overflowSize--;
+    return true;
+}
+
+void Strand::drain() {
+    draining++;
+
+    Task task;
+    for (size_t processed = 0; processed < DRAIN_LIMIT && next(task); processed++) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("❌ Výjimka v události místnosti: {}", e.what());
+        }
+        task = nullptr;
+    }
+
+    // Ještě ve strandu – listener vidí stav po celé dávce a neběží souběžně s ní
+    if (drainListener) {
+        drainListener();
+    }
+
+    // Uvolníme dávku a znovu zkontrolujeme – producent, který vložil úlohu
+    // před uvolněním, dávku nezařadil. Zbytek fronty dostane další dávku,
+    // ostatní místnosti se mezitím dostanou na řadu.
+    scheduled = false;
+    if ((inbox.hasReady() || overflowSize > 0) && !scheduled.exchange(true)) {
+        pool->submit([this] { drain(); });
+    }
+
+    // Poslední přístup ke strandu – teprve potom ho smí vlastník zrušit
+    draining--;
+}
+
+void Strand::setDrainListener(Task listener) {
+    drainListener = std::move(listener);
+}
+
+// ============================================================
+// METRIKY
+// ============================================================
+size_t Strand::getDepth() const {
+    return inbox.size() + overflowSize.load(std::memory_order_relaxed);
+}
+
+size_t Strand::getPeakDepth() const {
+    return peakDepth;
+}
+
+uint64_t Strand::getRejectedCount() const {
+    return rejected;
+}
+
+bool Strand::isIdle() const {
+    // Po uvolnění scheduled dávka ještě kontroluje frontu – hlídá ji draining
+    return !scheduled.load() && draining.load() == 0 && getDepth() == 0;
+}
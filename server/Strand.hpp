@@ -0,0 +1,66 @@
+#ifndef STRAND_HPP
+#define STRAND_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "MpscQueue.hpp"
+
+class WorkerPool;
+
+// Sériová fronta událostí jedné místnosti (actor).
+// Úlohy zařazené přes post()/tryPost() běží postupně v pořadí zařazení a nikdy
+// souběžně, i když je zpracovávají různá vlákna poolu. Stav hry, ke kterému se
+// přistupuje jen ze strandu, proto nepotřebuje zámky.
+//
+// Schránka je omezená lock-free MPSC fronta – I/O vlákna do ní zprávy hráčů
+// vkládají bez zámku a bez čekání na herní logiku. Plná schránka zprávu
+// odmítne (tryPost) a volající uplatní backpressure. Interní událost při plné
+// schránce přejde do rezervy; dokud rezerva není prázdná, řadí se do ní
+// i všechny další úlohy, aby pořadí zůstalo zachované.
+class Strand {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr size_t INBOX_CAPACITY = 256; // Kapacita schránky místnosti
+
+    explicit Strand(WorkerPool* pool);
+
+    bool tryPost(Task task); // Zpráva hráče – false při plné schránce
+    void post(Task task);    // Interní událost (start hry, časovač) – neztratí se ani při plné schránce
+    void setDrainListener(Task listener); // Volá se ve strandu po každé dávce (nastavit před prvním post)
+
+    // Metriky schránky
+    size_t getDepth() const;             // Aktuální počet čekajících úloh
+    size_t getPeakDepth() const;         // Nejvyšší zaznamenaný počet čekajících úloh
+    uint64_t getRejectedCount() const;   // Počet odmítnutých zpráv (plná schránka)
+    bool isIdle() const;                 // Nic nečeká a žádná dávka neběží (ani nedokončuje)
+
+private:
+    static constexpr size_t DRAIN_LIMIT = 32; // Max. úloh v jedné dávce (férovost mezi místnostmi)
+
+    enum class Spill { EMPTY, QUEUED, FULL }; // Výsledek zařazení do rezervy
+
+    WorkerPool* pool;
+    MpscQueue<Task> inbox;               // Schránka (lock-free)
+    std::mutex overflowMutex;            // Zámek rezervy
+    std::deque<Task> overflow;           // Rezerva interních událostí při plné schránce
+    std::atomic<size_t> overflowSize;    // Počet úloh v rezervě
+    std::atomic<bool> scheduled;         // Dávka je zařazená v poolu nebo právě běží
+    std::atomic<int> draining;           // Dávky, které ještě nevrátily řízení (i po uvolnění scheduled)
+    std::atomic<size_t> peakDepth;       // Nejvyšší hloubka schránky
+    std::atomic<uint64_t> rejected;      // Odmítnuté zprávy
+    Task drainListener;                  // Akce po dávce (zveřejnění souhrnu místnosti)
+
+    Spill spill(Task& task, size_t limit); // Zařadí úlohu za neprázdnou rezervu (nejvýš do limit úloh)
+    void schedule();      // Zařadí dávku do poolu, pokud tam ještě není
+    void recordDepth();   // Aktualizuje nejvyšší hloubku
+    bool next(Task& task); // Další úloha (schránka, potom rezerva)
+    void drain();         // Zpracuje dávku úloh na vlákně poolu
+};
+
+#endif // STRAND_HPP
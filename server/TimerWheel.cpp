@@ -0,0 +1,257 @@
+#include "TimerWheel.hpp"
+#include "Logger.hpp"
+
+
+TimerWheel::TimerWheel() : currentTick(0), pending(0), running(false) {
+    for (auto& level : heads) {
+        level.fill(NONE);
+    }
+}
+
+TimerWheel::~TimerWheel() {
+    stop();
+}
+
+void TimerWheel::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    worker = std::thread(&TimerWheel::run, this);
+    LOG_INFO("🕒 Časové kolo spuštěno (tik {} ms)", TICK.count());
+}
+
+void TimerWheel::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) {
+            return;
+        }
+        running = false;
+    }
+    wakeup.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+    LOG_INFO("🛑 Časové kolo zastaveno");
+}
+
+// ============================================================
+// PLÁNOVÁNÍ A RUŠENÍ
+// ============================================================
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::milliseconds delay, Callback callback) {
+    // Zaokrouhlení nahoru na celé tiky, nejméně jeden tik
+    uint64_t ticks = (delay.count() + TICK.count() - 1) / TICK.count();
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    Node& node = nodes[index];
+    node.deadline = currentTick + ticks;
+    node.callback = std::move(callback);
+    insert(index);
+    pending++;
+
+    return makeId(index, node.generation);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (id == 0) {
+        return false;
+    }
+
+    auto index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    auto generation = static_cast<uint32_t>(id >> 32);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Uzel už mezitím vypršel, byl zrušen nebo recyklován
+    if (index >= nodes.size() || nodes[index].generation != generation || nodes[index].level < 0) {
+        return false;
+    }
+
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+// ============================================================
+// POČÍTADLO ČASOVAČŮ VLASTNÍKA
+// ============================================================
+TimerWheel::Tracker::Token::Token(std::shared_ptr<std::atomic<int>> count) : count(std::move(count)) {
+    this->count->fetch_add(1, std::memory_order_relaxed);
+}
+
+TimerWheel::Tracker::Token::Token(const Token& other) : count(other.count) {
+    if (count) {
+        count->fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TimerWheel::Tracker::Token::~Token() {
+    // Release – co callback stihl udělat (např. zařadit úlohu do strandu), vidí i ten, kdo čte idle()
+    if (count) {
+        count->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+TimerWheel::Tracker::Token TimerWheel::Tracker::track() {
+    return Token(count);
+}
+
+bool TimerWheel::Tracker::idle() const {
+    return count->load(std::memory_order_acquire) == 0;
+}
+
+// ============================================================
+// SPRÁVA SLOTŮ
+// ============================================================
+void TimerWheel::insert(uint32_t index) {
+    Node& node = nodes[index];
+    uint64_t expires = node.deadline < currentTick ? currentTick : node.deadline;
+
+    // Příliš vzdálený časovač dočasně uložíme na konec rozsahu kola
+    constexpr int SPAN_BITS = SLOT_BITS * LEVELS;
+    if ((expires >> SPAN_BITS) != (currentTick >> SPAN_BITS)) {
+        expires = ((currentTick >> SPAN_BITS) << SPAN_BITS) | ((1ull << SPAN_BITS) - 1);
+    }
+
+    // Nejnižší úroveň, ve které se expirace a aktuální tik shodují ve všech vyšších bitech
+    int level = 0;
+    while (level < LEVELS - 1 &&
+           (expires >> (SLOT_BITS * (level + 1))) != (currentTick >> (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(expires >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+    node.level = level;
+    node.slot = slot;
+    node.prev = NONE;
+    node.next = heads[level][slot];
+    if (node.next != NONE) {
+        nodes[node.next].prev = index;
+    }
+    heads[level][slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes[index];
+
+    if (node.prev != NONE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.level][node.slot] = node.next;
+    }
+    if (node.next != NONE) {
+        nodes[node.next].prev = node.prev;
+    }
+
+    node.prev = NONE;
+    node.next = NONE;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes[index];
+    node.level = -1;
+    node.generation++;
+    node.callback = nullptr;
+    freeNodes.push_back(index);
+    pending--;
+}
+
+TimerWheel::TimerId TimerWheel::makeId(uint32_t index, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | index;
+}
+
+// ============================================================
+// CHOD KOLA
+// ============================================================
+void TimerWheel::advance(std::vector<std::pair<TimerId, Callback>>& expired) {
+    currentTick++;
+
+    // Přesun časovačů z vyšších úrovní, jejichž slot právě nastal
+    for (int level = 1; level < LEVELS; level++) {
+        if (currentTick & ((1ull << (SLOT_BITS * level)) - 1)) {
+            break;
+        }
+
+        uint32_t slot = static_cast<uint32_t>(currentTick >> (SLOT_BITS * level)) & (SLOTS - 1);
+        uint32_t index = heads[level][slot];
+        heads[level][slot] = NONE;
+
+        while (index != NONE) {
+            uint32_t next = nodes[index].next;
+            insert(index);
+            index = next;
+        }
+    }
+
+    // Vypršení aktuálního slotu nejnižší úrovně
+    uint32_t slot = static_cast<uint32_t>(currentTick) & (SLOTS - 1);
+    uint32_t index = heads[0][slot];
+    heads[0][slot] = NONE;
+
+    while (index != NONE) {
+        Node& node = nodes[index];
+        uint32_t next = node.next;
+
+        if (node.deadline > currentTick) {
+            // Časovač byl uložen zkráceně (mimo rozsah kola) – zařadíme znovu
+            insert(index);
+        } else {
+            node.prev = NONE;
+            node.next = NONE;
+            expired.emplace_back(makeId(index, node.generation), std::move(node.callback));
+            release(index);
+        }
+        index = next;
+    }
+}
+
+void TimerWheel::run() {
+    std::vector<std::pair<TimerId, Callback>> expired;
+    auto nextTick = std::chrono::steady_clock::now() + TICK;
+
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait_until(lock, nextTick, [this] { return !running; });
+            if (!running) {
+                break;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            while (nextTick <= now) {
+                advance(expired);
+                nextTick += TICK;
+            }
+        }
+
+        // Akce běží mimo zámek – mohou plánovat i rušit další časovače
+        for (auto& [id, callback] : expired) {
+            try {
+                callback(id);
+            } catch (const std::exception& e) {
+                LOG_ERROR("❌ Výjimka v časovači: {}", e.what());
+            }
+        }
+        expired.clear();
+    }
+}
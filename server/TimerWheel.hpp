@@ -0,0 +1,100 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hierarchické časové kolo pro timeouty serveru (welcome, reconnect, nečinnost).
+// Naplánování i zrušení časovače je O(1) – časovač je uzel ve spojovém seznamu
+// slotu. Každý tik zpracuje jen jeden slot nejnižší úrovně, vzdálenější časovače
+// se postupně přesouvají z vyšších úrovní dolů, takže práce odpovídá počtu
+// časovačů, které opravdu vyprší.
+class TimerWheel {
+public:
+    using TimerId = uint64_t;                      // Identifikátor časovače (0 = žádný)
+    using Callback = std::function<void(TimerId)>; // Volá se z vlákna kola s ID časovače
+
+    static constexpr std::chrono::milliseconds TICK{100}; // Rozlišení kola
+
+    // Počítadlo časovačů jednoho vlastníka (např. místnosti). Callback nese kopii
+    // tokenu a kolo ji drží, dokud časovač nezruší nebo dokud callback nedoběhne –
+    // idle() tedy znamená, že kolo už na vlastníka nesáhne. Čítač je sdílený,
+    // takže token smí přežít i vlastníka (kolo zahazuje callbacky až při zániku).
+    class Tracker {
+    public:
+        class Token {
+        public:
+            explicit Token(std::shared_ptr<std::atomic<int>> count);
+            Token(const Token& other);
+            Token(Token&& other) noexcept = default;
+            Token& operator=(const Token&) = delete;
+            Token& operator=(Token&&) = delete;
+            ~Token();
+
+        private:
+            std::shared_ptr<std::atomic<int>> count;
+        };
+
+        Token track();     // Token pro callback nového časovače
+        bool idle() const; // Kolo nedrží žádný callback s tokenem
+
+    private:
+        std::shared_ptr<std::atomic<int>> count = std::make_shared<std::atomic<int>>(0);
+    };
+
+    TimerWheel();
+    ~TimerWheel();
+
+    void start(); // Spustí vlákno kola
+    void stop();  // Zastaví vlákno kola (nevypršené časovače se zahodí)
+
+    TimerId schedule(std::chrono::milliseconds delay, Callback callback); // Naplánuje časovač
+    bool cancel(TimerId id); // Zruší časovač; false pokud už vypršel nebo neexistuje
+
+    // Gettery
+    size_t getPendingCount();
+
+private:
+    static constexpr int LEVELS = 4;                     // Počet úrovní (64^4 tiků ≈ 19 dní)
+    static constexpr int SLOT_BITS = 6;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;   // Počet slotů jedné úrovně
+    static constexpr uint32_t NONE = UINT32_MAX;         // Prázdný odkaz v seznamu
+
+    struct Node {
+        uint64_t deadline = 0;     // Tik, kdy má časovač vypršet
+        uint32_t generation = 1;   // Generace uzlu (ochrana proti zrušení recyklovaného uzlu)
+        uint32_t prev = NONE;      // Předchozí uzel ve slotu
+        uint32_t next = NONE;      // Další uzel ve slotu
+        int level = -1;            // Úroveň kola (-1 = uzel je volný)
+        uint32_t slot = 0;         // Slot v úrovni
+        Callback callback;         // Akce při vypršení
+    };
+
+    std::vector<Node> nodes;                            // Zásobník uzlů (index = dolních 32 bitů ID)
+    std::vector<uint32_t> freeNodes;                    // Volné uzly
+    std::array<std::array<uint32_t, SLOTS>, LEVELS> heads; // Hlavy seznamů jednotlivých slotů
+    uint64_t currentTick;                               // Aktuální tik kola
+    size_t pending;                                     // Počet naplánovaných časovačů
+
+    std::mutex mutex;                                   // Zámek kola
+    std::condition_variable wakeup;                     // Probuzení vlákna při zastavení
+    std::atomic<bool> running;                          // Příznak běhu
+    std::thread worker;                                 // Vlákno kola
+
+    void run(); // Smyčka vlákna kola
+    void insert(uint32_t index); // Zařadí uzel do slotu podle jeho deadline
+    void unlink(uint32_t index); // Vyjme uzel ze slotu
+    void release(uint32_t index); // Vrátí uzel mezi volné
+    void advance(std::vector<std::pair<TimerId, Callback>>& expired); // Posune kolo o jeden tik
+    static TimerId makeId(uint32_t index, uint32_t generation);
+};
+
+#endif // TIMER_WHEEL_HPP
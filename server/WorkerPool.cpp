@@ -0,0 +1,132 @@
+#include "WorkerPool.hpp"
+#include "Logger.hpp"
+
+
+namespace {
+    // Pool a fronta vlákna, na kterém volající běží (nullptr mimo pool)
+    thread_local const WorkerPool* currentPool = nullptr;
+    thread_local size_t currentQueue = 0;
+}
+
+WorkerPool::WorkerPool(int threadCount)
+    : threadCount(threadCount), nextQueue(0), pending(0), sleeping(0), running(false) {
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkerPool::run, this, static_cast<size_t>(i));
+    }
+    LOG_INFO("🧵 Herní vlákna spuštěna ({}, work-stealing)", threadCount);
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        if (!running) {
+            return;
+        }
+        running = false;
+    }
+    wakeup.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+
+    for (auto& queue : queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.clear();
+    }
+    pending = 0;
+    LOG_INFO("🛑 Herní vlákna zastavena");
+}
+
+// ============================================================
+// ZAŘAZENÍ ÚLOHY
+// ============================================================
+void WorkerPool::submit(Task task) {
+    // Z vlákna poolu do vlastní fronty, jinak střídavě do všech
+    size_t index = currentPool == this
+        ? currentQueue
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    pending++;
+
+    // Budíme jen jedno vlákno a jen pokud nějaké spí
+    if (sleeping > 0) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        wakeup.notify_one();
+    }
+}
+
+// ============================================================
+// PRACOVNÍ VLÁKNO
+// ============================================================
+bool WorkerPool::popLocal(size_t index, Task& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    // Ze začátku – úloha, která se sama znovu zařadí (dávka strandu), počká na ostatní
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkerPool::steal(size_t index, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        Queue& victim = *queues[(index + offset) % queues.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+
+        // Z opačného konce než vlastník – vlákna si co nejméně překáží
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void WorkerPool::run(size_t index) {
+    currentPool = this;
+    currentQueue = index;
+
+    while (running) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            pending--;
+            task();
+            continue;
+        }
+
+        // Nic k práci – spíme, dokud se neobjeví úloha (kdekoliv) nebo zastavení
+        std::unique_lock<std::mutex> lock(idleMutex);
+        sleeping++;
+        wakeup.wait(lock, [this] { return !running || pending > 0; });
+        sleeping--;
+    }
+
+    currentPool = nullptr;
+}
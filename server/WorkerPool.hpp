@@ -0,0 +1,60 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Sdílená vlákna pro herní logiku všech místností (work-stealing).
+// Místnosti nemají vlastní vlákna – jejich události (zprávy hráčů, odložené
+// herní události, start hry) běží přes Strand, který si na pool jen
+// zařadí dávku ke zpracování.
+//
+// Každé vlákno má vlastní frontu. Úloha zařazená z vlákna poolu jde do jeho
+// fronty, úlohy z ostatních vláken (reaktor, časové kolo, accept) se rozdělují
+// střídavě. Vlákno bere úlohy ze začátku své fronty; když je prázdná, ukradne
+// úlohu z konce fronty jiného vlákna. Nečinná vlákna spí a nová úloha probudí
+// jen jedno z nich.
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    void start(); // Spustí pracovní vlákna
+    void stop();  // Zastaví vlákna (nezpracované úlohy se zahodí)
+
+    void submit(Task task); // Zařadí úlohu ke zpracování
+
+    // Gettery
+    int getThreadCount() const { return threadCount; }
+
+private:
+    struct Queue {
+        std::mutex mutex;       // Zámek fronty (vlastník i zloději)
+        std::deque<Task> tasks; // Úlohy vlákna
+    };
+
+    int threadCount;                             // Počet pracovních vláken
+    std::vector<std::unique_ptr<Queue>> queues;  // Fronta každého vlákna
+    std::vector<std::thread> workers;            // Pracovní vlákna
+    std::atomic<size_t> nextQueue;               // Střídání front pro úlohy zvenčí
+    std::atomic<size_t> pending;                 // Počet zařazených a nezpracovaných úloh
+    std::atomic<int> sleeping;                   // Počet spících vláken
+    std::mutex idleMutex;                        // Zámek uspání vláken
+    std::condition_variable wakeup;              // Probuzení vlákna při nové úloze nebo zastavení
+    std::atomic<bool> running;                   // Příznak běhu
+
+    void run(size_t index); // Smyčka pracovního vlákna
+    bool popLocal(size_t index, Task& task); // Vezme úlohu ze začátku vlastní fronty
+    bool steal(size_t index, Task& task);    // Ukradne úlohu z konce cizí fronty
+};
+
+#endif // WORKER_POOL_HPP
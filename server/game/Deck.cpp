@@ -4,7 +4,7 @@
 #include <stdexcept>
 #include "Card.hpp"
 #include "Deck.hpp"
-#include <iostream>
+#include "../Logger.hpp"
 #include <ostream>
 
 Deck::Deck() : cardIndex(0) {
@@ -40,7 +40,7 @@ Card* Deck::dealCard() {
     if (hasNextCard()) {
         return cards[cardIndex++];
     }
-    std::cout << "No more cards in deck" << std::endl;
+    LOG_INFO("No more cards in deck");
     return nullptr;
 }
 
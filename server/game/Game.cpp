@@ -1,9 +1,9 @@
 #include <utility>
 #include <vector>
 #include <memory>
-#include <iostream>
 
 #include "Game.hpp"
+#include "../Logger.hpp"
 
 std::vector<int> ROZDAVANI_KARET = {7, 5};
 
@@ -42,7 +42,7 @@ Player* Game::getPlayer(int index) const {
 
 void Game::initPlayer(int number, std::string nick) {
     if (number < 0 || number >= static_cast<int>(players.size())) {
-        std::cerr << "Chybný index hráče: " << number << std::endl;
+        LOG_ERROR("Chybný index hráče: {}", number);
         return;
     }
 
@@ -137,7 +137,7 @@ void Game::nextPlayer() {
 
 // GAME_STATE_1 - nastavení trumfové barvy
 void Game::gameState1(Card card) {
-    std::cout << "Trumf: " << card.toString() << std::endl;
+    LOG_DEBUG("Trumf: {}", card.toString());
     gameLogic.setTrumph(card.getSuit());  // Nastavíme trumf podle karty
     state = State::LICITACE_TALON;        // Přejdeme na další stav
 }
@@ -145,7 +145,7 @@ void Game::gameState1(Card card) {
 // GAME_STATE_2 - dávání karet do talonu
 void Game::gameState2(Card card) {
     gameLogic.moveToTalon(card, *activePlayer);
-    std::cout << "Odhazuji kartu " << card.toString() << std::endl;
+    LOG_DEBUG("Odhazuji kartu {}", card.toString());
 
     if (gameLogic.getTalon().size() == 2) {
         if (higherGame && gameLogic.getMode() == Mode::BETL &&
@@ -187,7 +187,7 @@ void Game::gameState3(const std::string& label) {
     nextPlayer();
 
     gameStarted = 1;
-    std::cout << "Zvolena hra. Začíná licitace.\n";
+    LOG_INFO("Zvolena hra. Začíná licitace.");
 }
 
 // GAME_STATE_4 - reakce na "Dobrý"/"Špatný"
@@ -215,7 +215,7 @@ void Game::gameState4(const std::string& label) {
         state = State::HRA;
     }
 
-    std::cout << "Zahlášeno " << label << std::endl;
+    LOG_INFO("Zahlášeno {}", label);
 }
 
 // GAME_STATE_5 - volba mezi BETL a DURCH
@@ -235,7 +235,7 @@ void Game::gameState5(const std::string& label) {
         state = State::BETL;
     }
 
-    std::cout << "Změna hry " << label << std::endl;
+    LOG_INFO("Změna hry {}", label);
 }
 
 // CHOOSE_MODE_STATE - výběr herního módu
@@ -245,11 +245,11 @@ void Game::chooseModeState() {
             state = State::HRA;
             break;
         case Mode::BETL:
-            std::cout << "Trumph vynulován!" << std::endl;
+            LOG_INFO("Trumph vynulován!");
             gameLogic.setTrumph(std::nullopt);
             break;
         case Mode::DURCH:
-            std::cout << "Trumph vynulován!" << std::endl;
+            LOG_INFO("Trumph vynulován!");
             gameLogic.setTrumph(std::nullopt);
             state = State::DURCH;
             gameStarted = 1;
@@ -274,17 +274,17 @@ void Game::higher(Player* player, Mode mode) {
 // GAME_STATE_6 - normální hra (HRA)
 bool Game::gameState6(Card card) {
     if (trickSuitSet) {
-        std::cout << "Kontroluji zahranou kartu." << std::endl;
+        LOG_DEBUG("Kontroluji zahranou kartu.");
         if (!activePlayer->checkPlayedCard(trickSuit, gameLogic.getTrumph(), card, playedCards, gameLogic.getMode())) {
             return false;
         }
     } else {
         trickSuit = card.getSuit();
         trickSuitSet = true;
-        std::cout << "Barvu štychu: " << suitToString(trickSuit) << std::endl;
+        LOG_DEBUG("Barvu štychu: {}", suitToString(trickSuit));
     }
 
-    std::cout << "Přidávám kartu " << card.toString() << std::endl;
+    LOG_DEBUG("Přidávám kartu {}", card.toString());
     playedCards.insert_or_assign(activePlayer->getNumber(), card);
     activePlayer->getHand().removeCard(card);
 
@@ -295,9 +295,9 @@ bool Game::gameState6(Card card) {
     }
 
     if (allCardsPlayed) {
-        std::cout << "Štych je kompletní, vyhodnocuji..." << std::endl;
+        LOG_DEBUG("Štych je kompletní, vyhodnocuji...");
         auto [fst, snd] = gameLogic.trickDecision(playedCards, startingPlayerIndex);
-        std::cout << "Vítěz je #" << fst << " s vítěznou kartou " << snd.toString() << std::endl;
+        LOG_DEBUG("Vítěz je #{} s vítěznou kartou {}", fst, snd.toString());
         trickWinner = fst;
         trickWinnerSet = true;
         waitingForTrickEnd = true;
@@ -315,7 +315,7 @@ bool Game::gameState6(Card card) {
     }
 
     if (allHandsEmpty) {
-        std::cout << "Hráči již nemají karty, nastává konec hry" << std::endl;
+        LOG_INFO("Hráči již nemají karty, nastává konec hry");
         result = gameResult(nullptr);
         state = State::END;
         return true;
@@ -349,9 +349,9 @@ bool Game::gameState7(Card card) {
     }
 
     if (allCardsPlayed) {
-        std::cout << "Štych je kompletní, vyhodnocuji..." << std::endl;
+        LOG_DEBUG("Štych je kompletní, vyhodnocuji...");
         auto [fst, snd] = gameLogic.trickDecision(playedCards, startingPlayerIndex);
-        std::cout << "Vítěz je #" << fst << " s vítěznou kartou " << snd.toString() << std::endl;
+        LOG_DEBUG("Vítěz je #{} s vítěznou kartou {}", fst, snd.toString());
         trickWinner = fst;
         trickWinnerSet = true;
         waitingForTrickEnd = true;
@@ -434,7 +434,7 @@ bool Game::gameHandler(Card &card, std::string &label) {
         case 6: result = gameState6(card); break;
         case 7: result = gameState7(card); break;
         case 8: result = gameState7(card); break;
-        default: std::cout << "ERROR: Unknown state" << std::endl; break;
+        default: LOG_INFO("ERROR: Unknown state"); break;
     }
 
     if (oldState != state) {
@@ -0,0 +1,872 @@
+// Generátor zátěže – headless boti, kteří hrají Mariáš přes protokol serveru.
+// Každý bot projde handshake (WELCOME -> CONNECT -> AUTHORIZE), licituje,
+// hraje karty povolené pravidly z server/game, potvrzuje štychy (TRICK),
+// po konci hry žádá o další (RESET) a pravidelně posílá PING. Volitelně
+// uprostřed hry spadne a vrátí se přes RECONNECT s tokenem relace.
+//
+// Latence (RTT) se měří od odeslání požadavku po odpověď serveru stejnému
+// spojení: CONNECT -> AUTHORIZE, RECONNECT -> RECONNECT, PING -> PONG,
+// CARD/BIDDING -> STATE (nebo INVALID), RESET -> WAIT_LOBBY.
+// TRICK odpověď odesílateli nemá, počítá se jen do propustnosti.
+//
+// Spuštění:  ./load_gen [volby]   (-h vypíše nápovědu)
+
+#include "server/FrameBuffer.hpp"
+#include "server/Metrics.hpp"
+#include "server/Protocol.hpp"
+#include "server/game/Player.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Protocol::MessageType;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t MESSAGE_TYPES = Metrics::MESSAGE_TYPES;
+    constexpr int MAX_EVENTS = 256;                                   // Událostí na jedno epoll_wait
+    constexpr auto TICK = std::chrono::milliseconds(10);              // Perioda kontroly časovačů botů
+    constexpr auto RETRY_DELAY = std::chrono::seconds(1);             // Nový pokus po odmítnutí / chybě
+    constexpr auto PROGRESS_INTERVAL = std::chrono::seconds(5);       // Průběžný výpis
+
+    struct Options {
+        std::string ip = "127.0.0.1";
+        int port = 10000;
+        int connections = 100;    // Počet botů
+        int threads = 2;          // Vlákna generátoru (každé s vlastním epoll)
+        int duration = 30;        // Délka měření v sekundách
+        int rampRate = 500;       // Nových spojení za sekundu při rozjezdu
+        int pingInterval = 2000;  // Perioda PING v ms (server odpojuje po 10 s ticha)
+        int dropPercent = 0;      // Pravděpodobnost (%) výpadku bota místo tahu
+        int reconnectDelay = 500; // Prodleva před RECONNECT v ms
+    };
+
+    // ============================================================
+    // STATISTIKY
+    // ============================================================
+
+    // Statistiky jednoho vlákna – zapisuje jen vlastní vlákno, sloučí se na konci
+    struct Stats {
+        std::array<Metrics::Histogram, MESSAGE_TYPES> rtt{}; // RTT podle typu požadavku (ns)
+        std::array<uint64_t, MESSAGE_TYPES> sent{};
+        std::array<uint64_t, MESSAGE_TYPES> received{};
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t connects = 0;          // Navázaná spojení (AUTHORIZE)
+        uint64_t rejected = 0;          // DISCONNECT od serveru (např. plné místnosti)
+        uint64_t connectFailures = 0;   // Chyby connect()
+        uint64_t serverCloses = 0;      // Spojení zavřená serverem
+        uint64_t malformed = 0;         // Rámce, které nejdou parsovat
+        uint64_t games = 0;             // Dokončené hry (RESULT hráči #0)
+        uint64_t invalidMoves = 0;      // INVALID od serveru
+        uint64_t injectedDrops = 0;     // Vyvolané výpadky
+        uint64_t reconnects = 0;        // Úspěšné RECONNECT
+        uint64_t reconnectFailures = 0; // Odmítnuté RECONNECT
+
+        void recordRtt(MessageType type, Clock::duration elapsed) {
+            auto value = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            Metrics::Histogram& histogram = rtt[index(type)];
+            histogram.counts[Metrics::Histogram::bucketFor(value)]++;
+            histogram.count++;
+            histogram.sum += value;
+            histogram.max = std::max(histogram.max, value);
+        }
+
+        void merge(const Stats& other) {
+            for (size_t type = 0; type < MESSAGE_TYPES; type++) {
+                for (size_t bucket = 0; bucket < Metrics::Histogram::BUCKETS; bucket++) {
+                    rtt[type].counts[bucket] += other.rtt[type].counts[bucket];
+                }
+                rtt[type].count += other.rtt[type].count;
+                rtt[type].sum += other.rtt[type].sum;
+                rtt[type].max = std::max(rtt[type].max, other.rtt[type].max);
+                sent[type] += other.sent[type];
+                received[type] += other.received[type];
+            }
+            bytesSent += other.bytesSent;
+            bytesReceived += other.bytesReceived;
+            connects += other.connects;
+            rejected += other.rejected;
+            connectFailures += other.connectFailures;
+            serverCloses += other.serverCloses;
+            malformed += other.malformed;
+            games += other.games;
+            invalidMoves += other.invalidMoves;
+            injectedDrops += other.injectedDrops;
+            reconnects += other.reconnects;
+            reconnectFailures += other.reconnectFailures;
+        }
+
+        static size_t index(MessageType type) {
+            auto value = static_cast<size_t>(type);
+            return value < MESSAGE_TYPES ? value : 0;
+        }
+    };
+
+    // ============================================================
+    // BOT
+    // ============================================================
+    enum class Phase {
+        IDLE,          // Čeká na (nové) připojení
+        CONNECTING,    // Probíhá neblokující connect()
+        WELCOME,       // Čeká na WELCOME, pak pošle CONNECT
+        AUTHORIZING,   // CONNECT/RECONNECT odeslán
+        PLAYING,       // Autorizován, hraje
+    };
+
+    struct Bot {
+        int id = 0;
+        uint32_t slot = 0;              // Index v Driver::bots (data epoll událostí)
+        std::string nickname;
+        int socket = -1;
+        Phase phase = Phase::IDLE;
+        Clock::time_point wakeAt;       // Kdy se (znovu) připojit
+        Clock::time_point nextPing;
+
+        FrameBuffer input;
+        std::string output;             // Neodeslaná část výstupu
+        bool wantWrite = false;         // Socket je v epoll registrován i s EPOLLOUT
+        std::string frameBuffer;        // Buffer serializace
+
+        // Relace
+        int number = 0;                 // Číslo hráče v místnosti
+        uint32_t lastPacketID = 0;      // Poslední přijaté ID (potvrzení pro server)
+        std::string token;              // Token pro RECONNECT
+        bool resuming = false;          // Po připojení poslat RECONNECT místo CONNECT
+        std::array<Clock::time_point, MESSAGE_TYPES> pending{}; // Odeslání čekajícího požadavku
+
+        // Pohled na hru
+        State state = State::ROZDANI_KARET;
+        Mode mode = Mode::HRA;
+        std::optional<CardSuits> trump;
+        std::vector<Card> hand;
+        std::vector<Card> table;        // Karty aktuálního štychu
+        std::vector<Card> rejected;     // Karty odmítnuté v tomto tahu (INVALID)
+        std::optional<Card> lastCard;   // Naposledy zahraná karta
+        std::optional<State> lastBid;   // Stav licitace, ve kterém bot naposledy hlásil
+        int bidRepeats = 0;             // Kolikrát za sebou byl v tomto stavu vyzván znovu
+        bool turnPending = false;       // Bot je na tahu a ještě nehrál
+    };
+
+    std::vector<Card> parseCards(std::string_view text) {
+        std::vector<Card> cards;
+        while (!text.empty()) {
+            size_t end = std::min(text.find(':'), text.size());
+            if (end > 0) {
+                try {
+                    cards.push_back(cardMapping(std::string(text.substr(0, end))));
+                } catch (const std::invalid_argument&) {
+                    // Neznámý zápis karty – přeskočíme
+                }
+            }
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+        return cards;
+    }
+
+    std::optional<CardSuits> parseSuit(std::string_view text) {
+        for (CardSuits suit : {CardSuits::SRDCE, CardSuits::KULE, CardSuits::ZALUDY, CardSuits::LISTY}) {
+            if (suitToString(suit) == text) {
+                return suit;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // ============================================================
+    // VLÁKNO GENERÁTORU
+    // ============================================================
+    class Driver {
+    public:
+        Driver(const Options& options, std::vector<int> botIds)
+            : options(options), random(std::random_device{}()) {
+            auto start = Clock::now();
+            for (int id : botIds) {
+                auto bot = std::make_unique<Bot>();
+                bot->id = id;
+                bot->slot = static_cast<uint32_t>(bots.size());
+                bot->nickname = "bot" + std::to_string(id);
+                // Rozjezd – spojení se otevírají postupně rychlostí rampRate
+                bot->wakeAt = start + std::chrono::microseconds(1000000LL * id / options.rampRate);
+                bots.push_back(std::move(bot));
+            }
+        }
+
+        ~Driver() {
+            if (epoll >= 0) {
+                close(epoll);
+            }
+        }
+
+        void run(const std::atomic<bool>& running) {
+            epoll = epoll_create1(0);
+            if (epoll < 0) {
+                std::cerr << "❌ Nepodařilo se vytvořit epoll: " << strerror(errno) << std::endl;
+                return;
+            }
+
+            std::array<epoll_event, MAX_EVENTS> events{};
+            while (running.load(std::memory_order_relaxed)) {
+                int count = epoll_wait(epoll, events.data(), MAX_EVENTS,
+                                       static_cast<int>(TICK.count()));
+                for (int i = 0; i < count; i++) {
+                    Bot& bot = *bots[events[i].data.u32];
+                    if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+                        onWritable(bot);
+                    }
+                    if (bot.socket >= 0 && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                        onReadable(bot);
+                    }
+                }
+                onTick(Clock::now());
+            }
+
+            for (auto& bot : bots) {
+                closeBot(*bot);
+            }
+        }
+
+        const Stats& getStats() const { return stats; }
+        uint64_t getGames() const { return progressGames.load(std::memory_order_relaxed); }
+        uint64_t getMessages() const { return progressMessages.load(std::memory_order_relaxed); }
+        uint64_t getPlaying() const { return progressPlaying.load(std::memory_order_relaxed); }
+
+    private:
+        const Options& options;
+        std::vector<std::unique_ptr<Bot>> bots;
+        int epoll = -1;
+        Stats stats;
+        std::mt19937 random;
+
+        // Průběžné čítače pro hlavní vlákno
+        std::atomic<uint64_t> progressGames{0};
+        std::atomic<uint64_t> progressMessages{0};
+        std::atomic<uint64_t> progressPlaying{0};
+
+        // ===== Spojení =====
+        void connectBot(Bot& bot) {
+            bot.socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            if (bot.socket < 0) {
+                stats.connectFailures++;
+                bot.wakeAt = Clock::now() + RETRY_DELAY;
+                return;
+            }
+
+            int one = 1;
+            setsockopt(bot.socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(options.port);
+            inet_pton(AF_INET, options.ip.c_str(), &address.sin_addr);
+
+            if (connect(bot.socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 &&
+                errno != EINPROGRESS) {
+                stats.connectFailures++;
+                closeBot(bot);
+                bot.wakeAt = Clock::now() + RETRY_DELAY;
+                return;
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLOUT;
+            event.data.u32 = bot.slot;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, bot.socket, &event);
+
+            bot.phase = Phase::CONNECTING;
+            bot.wantWrite = true;
+            bot.input = FrameBuffer();
+            bot.output.clear();
+            bot.pending = {};
+        }
+
+        void closeBot(Bot& bot) {
+            if (bot.socket >= 0) {
+                epoll_ctl(epoll, EPOLL_CTL_DEL, bot.socket, nullptr);
+                close(bot.socket);
+                bot.socket = -1;
+            }
+            if (bot.phase == Phase::PLAYING) {
+                progressPlaying.fetch_sub(1, std::memory_order_relaxed);
+            }
+            bot.phase = Phase::IDLE;
+        }
+
+        // Výpadek spojení – s platným tokenem se bot vrátí přes RECONNECT
+        void dropBot(Bot& bot, std::chrono::milliseconds delay) {
+            closeBot(bot);
+            bot.resuming = !bot.token.empty();
+            bot.wakeAt = Clock::now() + delay;
+        }
+
+        // Úplně nová relace (po odmítnutí nebo neúspěšném reconnectu)
+        void resetSession(Bot& bot) {
+            closeBot(bot);
+            bot.token.clear();
+            bot.resuming = false;
+            bot.lastPacketID = 0;
+            bot.turnPending = false;
+            bot.wakeAt = Clock::now() + RETRY_DELAY;
+        }
+
+        void onWritable(Bot& bot) {
+            if (bot.phase == Phase::CONNECTING) {
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(bot.socket, SOL_SOCKET, SO_ERROR, &error, &length);
+                if (error != 0) {
+                    stats.connectFailures++;
+                    closeBot(bot);
+                    bot.wakeAt = Clock::now() + RETRY_DELAY;
+                    return;
+                }
+                bot.phase = Phase::WELCOME;
+                if (bot.resuming) {
+                    // Server obsazenou místnost nepozdraví – RECONNECT jde hned po připojení
+                    bot.phase = Phase::AUTHORIZING;
+                    send(bot, MessageType::RECONNECT, {bot.token, std::to_string(bot.lastPacketID)});
+                    return;
+                }
+            }
+            flush(bot);
+        }
+
+        void onReadable(Bot& bot) {
+            while (bot.socket >= 0) {
+                ssize_t received = bot.input.fill(bot.socket);
+                if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    stats.serverCloses++;
+                    if (bot.phase == Phase::PLAYING) {
+                        dropBot(bot, std::chrono::milliseconds(options.reconnectDelay));
+                    } else {
+                        resetSession(bot);
+                    }
+                    return;
+                }
+                if (received < 0) {
+                    return;
+                }
+
+                stats.bytesReceived += static_cast<uint64_t>(received);
+                std::string_view frame;
+                while (bot.socket >= 0 && bot.input.nextFrame(frame)) {
+                    Protocol::MessageView message;
+                    if (!Protocol::parse(frame, message)) {
+                        stats.malformed++;
+                        continue;
+                    }
+                    onMessage(bot, message);
+                }
+                if (bot.input.takeDrained()) {
+                    return;
+                }
+            }
+        }
+
+        // ===== Odesílání =====
+        void send(Bot& bot, MessageType type, const std::vector<std::string>& fields) {
+            Protocol::Message message(bot.lastPacketID, static_cast<uint8_t>(bot.number), type, fields);
+            std::string_view frame = Protocol::serialize(message, bot.frameBuffer);
+            bot.output.append(frame.data(), frame.size());
+
+            size_t index = Stats::index(type);
+            stats.sent[index]++;
+            stats.bytesSent += frame.size();
+            bot.pending[index] = Clock::now();
+            progressMessages.fetch_add(1, std::memory_order_relaxed);
+            flush(bot);
+        }
+
+        void flush(Bot& bot) {
+            if (bot.socket < 0 || bot.phase == Phase::CONNECTING) {
+                return;
+            }
+
+            while (!bot.output.empty()) {
+                ssize_t written = ::send(bot.socket, bot.output.data(), bot.output.size(), MSG_NOSIGNAL);
+                if (written < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        break;
+                    }
+                    return; // Chybu ohlásí čtení (EPOLLHUP/EPOLLERR)
+                }
+                bot.output.erase(0, static_cast<size_t>(written));
+            }
+
+            // EPOLLOUT jen dokud je co odesílat (epoll_ctl jen při změně)
+            bool wantWrite = !bot.output.empty();
+            if (wantWrite != bot.wantWrite) {
+                epoll_event event{};
+                event.events = wantWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+                event.data.u32 = bot.slot;
+                epoll_ctl(epoll, EPOLL_CTL_MOD, bot.socket, &event);
+                bot.wantWrite = wantWrite;
+            }
+        }
+
+        // Odpověď na čekající požadavek – změří RTT
+        void answer(Bot& bot, MessageType request) {
+            auto& sentAt = bot.pending[Stats::index(request)];
+            if (sentAt != Clock::time_point{}) {
+                stats.recordRtt(request, Clock::now() - sentAt);
+                sentAt = Clock::time_point{};
+            }
+        }
+
+        // ===== Zprávy serveru =====
+        void onMessage(Bot& bot, const Protocol::MessageView& message) {
+            stats.received[Stats::index(message.type)]++;
+            progressMessages.fetch_add(1, std::memory_order_relaxed);
+
+            // WELCOME/DISCONNECT dočasného spojení nepatří do sekvence obnovované relace
+            bool foreign = bot.resuming &&
+                           (message.type == MessageType::WELCOME || message.type == MessageType::DISCONNECT);
+            if (!foreign) {
+                bot.lastPacketID = message.packetID;
+            }
+
+            switch (message.type) {
+                case MessageType::WELCOME: onWelcome(bot, message); break;
+                case MessageType::AUTHORIZE:
+                    answer(bot, MessageType::CONNECT);
+                    bot.token = message.fieldCount > 0 ? std::string(message.fields[0]) : std::string();
+                    enterPlaying(bot);
+                    stats.connects++;
+                    break;
+                case MessageType::RECONNECT:
+                    answer(bot, MessageType::RECONNECT);
+                    stats.reconnects++;
+                    bot.resuming = false;
+                    enterPlaying(bot);
+                    act(bot);
+                    break;
+                case MessageType::DISCONNECT:
+                    if (bot.resuming) {
+                        stats.reconnectFailures++;
+                    } else {
+                        stats.rejected++;
+                    }
+                    resetSession(bot);
+                    break;
+                case MessageType::PONG: answer(bot, MessageType::PING); break;
+                case MessageType::WAIT_LOBBY: answer(bot, MessageType::RESET); break;
+                case MessageType::GAME_START: onGameStart(bot, message); break;
+                case MessageType::CLIENT_DATA:
+                    if (message.fieldCount > 1) {
+                        bot.hand = parseCards(message.fields[1]);
+                    }
+                    break;
+                case MessageType::STATE: onState(bot, message); break;
+                case MessageType::INVALID:
+                    answer(bot, MessageType::CARD);
+                    stats.invalidMoves++;
+                    if (bot.lastCard) {
+                        bot.rejected.push_back(*bot.lastCard);
+                    }
+                    break;
+                case MessageType::YOUR_TURN: onYourTurn(bot, message); break;
+                case MessageType::RESULT:
+                    if (bot.number == 0) {
+                        stats.games++;
+                        progressGames.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void enterPlaying(Bot& bot) {
+            if (bot.phase != Phase::PLAYING) {
+                progressPlaying.fetch_add(1, std::memory_order_relaxed);
+            }
+            bot.phase = Phase::PLAYING;
+            bot.nextPing = Clock::now() + std::chrono::milliseconds(options.pingInterval);
+        }
+
+        void onWelcome(Bot& bot, const Protocol::MessageView& message) {
+            if (bot.phase != Phase::WELCOME) {
+                return;
+            }
+
+            int number = 0;
+            if (message.fieldCount > 0 && Protocol::parseNumber(message.fields[0], number)) {
+                bot.number = number;
+            }
+            send(bot, MessageType::CONNECT, {bot.nickname});
+            bot.phase = Phase::AUTHORIZING;
+        }
+
+        void onGameStart(Bot& bot, const Protocol::MessageView& message) {
+            // Úvodní GAME_START je prázdný, druhý nese "číslo-přezdívka|karty|soupeři|licitátor|na tahu"
+            bot.state = State::ROZDANI_KARET;
+            bot.trump.reset();
+            bot.table.clear();
+            bot.rejected.clear();
+            bot.lastBid.reset();
+            bot.bidRepeats = 0;
+            bot.turnPending = false;
+            if (message.fieldCount < 5) {
+                return;
+            }
+
+            bot.hand = parseCards(message.fields[1]);
+            bot.state = State::LICITACE_TRUMF;
+            int activePlayer = -1;
+            if (Protocol::parseNumber(message.fields[4], activePlayer) && activePlayer == bot.number) {
+                bot.turnPending = true;
+                act(bot);
+            }
+        }
+
+        void onState(Bot& bot, const Protocol::MessageView& message) {
+            // state|stateChanged|gameStarted|mode|trumph|isPlayedCards|cards|change_trick
+            int value = 0;
+            if (message.fieldCount > 0 && Protocol::parseNumber(message.fields[0], value)) {
+                bot.state = static_cast<State>(value);
+            }
+            if (message.fieldCount > 4) {
+                if (Protocol::parseNumber(message.fields[3], value)) {
+                    bot.mode = static_cast<Mode>(value);
+                }
+                bot.trump = parseSuit(message.fields[4]);
+            }
+
+            // Odmítnuté karty platí jen v rámci jednoho tahu (INVALID -> YOUR_TURN bez STATE)
+            bot.rejected.clear();
+
+            bool playedCards = message.fieldCount > 6 && message.fields[5] == "1";
+            bot.table = playedCards ? parseCards(message.fields[6]) : std::vector<Card>{};
+
+            if (message.fieldCount > 7 && message.fields[7] == "1") {
+                // Štych je kompletní – každý hráč ho potvrdí, pak začíná vítěz
+                bot.table.clear();
+                if (bot.state != State::END) {
+                    send(bot, MessageType::TRICK, {});
+                }
+            }
+
+            // Odpověď na CARD/BIDDING je rozeslaný stav
+            answer(bot, MessageType::CARD);
+            answer(bot, MessageType::BIDDING);
+        }
+
+        void onYourTurn(Bot& bot, const Protocol::MessageView& message) {
+            if (message.fieldCount > 0 && message.fields[0].rfind("Budete", 0) == 0) {
+                // Konec hry – hrajeme znovu
+                send(bot, MessageType::RESET, {"ANO"});
+                return;
+            }
+            bot.turnPending = true;
+            act(bot);
+        }
+
+        // ===== Tah =====
+        void act(Bot& bot) {
+            if (!bot.turnPending || bot.phase != Phase::PLAYING || bot.state == State::END ||
+                bot.state == State::ROZDANI_KARET) {
+                return;
+            }
+
+            // Vyvolaný výpadek místo tahu – tah se dohraje po reconnectu
+            if (options.dropPercent > 0 && std::uniform_int_distribution<int>(1, 100)(random) <= options.dropPercent) {
+                stats.injectedDrops++;
+                dropBot(bot, std::chrono::milliseconds(options.reconnectDelay));
+                return;
+            }
+
+            bot.turnPending = false;
+            switch (bot.state) {
+                case State::LICITACE_TRUMF:
+                case State::LICITACE_TALON:
+                    playCard(bot, false);
+                    break;
+                case State::LICITACE_HRA:
+                    bid(bot, "HRA", "HRA");
+                    break;
+                case State::LICITACE_DOBRY_SPATNY:
+                    bid(bot, "Dobrý", "Špatný");
+                    break;
+                case State::LICITACE_BETL_DURCH:
+                    bid(bot, "BETL", "DURCH");
+                    break;
+                default:
+                    playCard(bot, true);
+                    break;
+            }
+        }
+
+        // Hlášení v licitaci. Když server po hlášení nechá stav i tah beze změny
+        // (např. "Dobrý" prostředního hráče ve hře tří), bot příště zvýší.
+        void bid(Bot& bot, const char* label, const char* raise) {
+            bot.bidRepeats = bot.lastBid == bot.state ? bot.bidRepeats + 1 : 0;
+            bot.lastBid = bot.state;
+            send(bot, MessageType::BIDDING, {bot.bidRepeats == 0 ? label : raise});
+        }
+
+        void playCard(Bot& bot, bool checkRules) {
+            std::optional<Card> choice;
+            for (const Card& card : bot.hand) {
+                if (std::find(bot.rejected.begin(), bot.rejected.end(), card) != bot.rejected.end()) {
+                    continue;
+                }
+                if (!checkRules || isLegal(bot, card)) {
+                    choice = card;
+                    break;
+                }
+            }
+
+            // Pravidla nic nepustila (neznámé pořadí štychu) – zkusíme první neodmítnutou kartu
+            if (!choice) {
+                for (const Card& card : bot.hand) {
+                    if (std::find(bot.rejected.begin(), bot.rejected.end(), card) == bot.rejected.end()) {
+                        choice = card;
+                        break;
+                    }
+                }
+            }
+            if (!choice) {
+                bot.rejected.clear();
+                return;
+            }
+
+            bot.lastCard = choice;
+            send(bot, MessageType::CARD, {choice->toString()});
+        }
+
+        // Kontrola tahu pravidly serveru (Player::checkPlayedCard). STATE nese karty
+        // štychu podle čísla hráče, ne podle pořadí – barvu štychu proto zkoušíme
+        // podle každé karty na stole; případný INVALID vyřadí kartu pro další pokus.
+        bool isLegal(const Bot& bot, const Card& card) {
+            if (bot.table.empty()) {
+                return true;
+            }
+
+            Player judge(bot.number, bot.nickname);
+            for (const Card& held : bot.hand) {
+                judge.addCard(held);
+            }
+            std::map<int, Card> played;
+            for (size_t i = 0; i < bot.table.size(); i++) {
+                played.insert_or_assign(static_cast<int>(i), bot.table[i]);
+            }
+
+            for (const Card& lead : bot.table) {
+                if (judge.checkPlayedCard(lead.getSuit(), bot.trump, card, played, bot.mode)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // ===== Časovače =====
+        void onTick(Clock::time_point now) {
+            for (auto& owned : bots) {
+                Bot& bot = *owned;
+                if (bot.phase == Phase::IDLE && now >= bot.wakeAt) {
+                    connectBot(bot);
+                } else if (bot.phase == Phase::PLAYING && now >= bot.nextPing) {
+                    send(bot, MessageType::PING, {});
+                    bot.nextPing = now + std::chrono::milliseconds(options.pingInterval);
+                }
+            }
+        }
+    };
+
+    // ============================================================
+    // VÝPIS
+    // ============================================================
+    void printReport(const Options& options, const Stats& stats, double seconds) {
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        for (size_t type = 0; type < MESSAGE_TYPES; type++) {
+            sent += stats.sent[type];
+            received += stats.received[type];
+        }
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "\n📊 VÝSLEDKY (" << seconds << " s, " << options.connections << " botů, "
+                  << options.threads << " vláken)\n";
+        std::cout << std::string(72, '=') << "\n";
+        std::cout << "Spojení:    navázáno " << stats.connects << ", odmítnuto " << stats.rejected
+                  << ", chyby connect " << stats.connectFailures << ", zavřeno serverem "
+                  << stats.serverCloses << "\n";
+        std::cout << "Hry:        dokončeno " << stats.games << " (" << stats.games / seconds
+                  << "/s), neplatné tahy " << stats.invalidMoves << "\n";
+        std::cout << "Reconnecty: úspěšné " << stats.reconnects << ", odmítnuté " << stats.reconnectFailures
+                  << ", vyvolané výpadky " << stats.injectedDrops << "\n";
+        std::cout << "Zprávy:     odesláno " << sent << " (" << sent / seconds << "/s, "
+                  << stats.bytesSent / 1024 << " KiB), přijato " << received << " ("
+                  << received / seconds << "/s, " << stats.bytesReceived / 1024 << " KiB)";
+        if (stats.malformed > 0) {
+            std::cout << ", nečitelné " << stats.malformed;
+        }
+        std::cout << "\n\n";
+
+        std::cout << std::left << std::setw(12) << "typ" << std::right
+                  << std::setw(10) << "odesláno" << std::setw(10) << "přijato" << std::setw(10) << "/s"
+                  << std::setw(11) << "p50 µs" << std::setw(11) << "p99 µs"
+                  << std::setw(12) << "p99.9 µs" << std::setw(11) << "max µs" << "\n";
+
+        for (size_t type = 1; type < MESSAGE_TYPES; type++) {
+            const Metrics::Histogram& rtt = stats.rtt[type];
+            if (stats.sent[type] == 0 && stats.received[type] == 0) {
+                continue;
+            }
+
+            std::cout << std::left << std::setw(12)
+                      << Protocol::messageTypeName(static_cast<MessageType>(type)) << std::right
+                      << std::setw(10) << stats.sent[type] << std::setw(10) << stats.received[type]
+                      << std::setw(10) << (stats.sent[type] + stats.received[type]) / seconds;
+            if (rtt.count > 0) {
+                std::cout << std::setw(11) << rtt.percentile(50) / 1000.0
+                          << std::setw(11) << rtt.percentile(99) / 1000.0
+                          << std::setw(12) << rtt.percentile(99.9) / 1000.0
+                          << std::setw(11) << rtt.max / 1000.0;
+            }
+            std::cout << "\n";
+        }
+        std::cout << std::string(72, '=') << std::endl;
+    }
+
+    void printUsage(const char* programName) {
+        std::cout << "Použití: " << programName << " [volby]\n\n";
+        std::cout << "Volby:\n";
+        std::cout << "  -i IP        IP adresa serveru (výchozí: 127.0.0.1)\n";
+        std::cout << "  -p PORT      Port serveru (výchozí: 10000)\n";
+        std::cout << "  -c BOTS      Počet botů / spojení (výchozí: 100)\n";
+        std::cout << "  -t THREADS   Počet vláken generátoru (výchozí: 2)\n";
+        std::cout << "  -d SECONDS   Délka měření v sekundách (výchozí: 30)\n";
+        std::cout << "  -r RATE      Nových spojení za sekundu při rozjezdu (výchozí: 500)\n";
+        std::cout << "  -P MS        Perioda PING v ms (výchozí: 2000)\n";
+        std::cout << "  -x PERCENT   Pravděpodobnost výpadku bota místo tahu, vrací se přes RECONNECT (výchozí: 0)\n";
+        std::cout << "  -R MS        Prodleva před RECONNECT v ms (výchozí: 500)\n";
+        std::cout << "  -h           Zobrazit tuto nápovědu\n\n";
+        std::cout << "Server přidává místnosti podle potřeby (-l serveru je jen bezpečnostní limit).\n";
+    }
+
+    // Číselná volba v rozsahu – false při chybě
+    bool parseOption(const char* text, int min, int max, int& value) {
+        return Protocol::parseNumber(text, value) && value >= min && value <= max;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* option = argv[i];
+        bool ok = true;
+        if (strcmp(argv[i], "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (i + 1 >= argc) {
+            ok = false;
+        } else if (strcmp(argv[i], "-i") == 0) {
+            in_addr address{};
+            options.ip = argv[++i];
+            ok = inet_pton(AF_INET, options.ip.c_str(), &address) == 1;
+        } else if (strcmp(argv[i], "-p") == 0) {
+            ok = parseOption(argv[++i], 1, 65535, options.port);
+        } else if (strcmp(argv[i], "-c") == 0) {
+            ok = parseOption(argv[++i], 1, 100000, options.connections);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            ok = parseOption(argv[++i], 1, 64, options.threads);
+        } else if (strcmp(argv[i], "-d") == 0) {
+            ok = parseOption(argv[++i], 1, 86400, options.duration);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            ok = parseOption(argv[++i], 1, 1000000, options.rampRate);
+        } else if (strcmp(argv[i], "-P") == 0) {
+            ok = parseOption(argv[++i], 100, 60000, options.pingInterval);
+        } else if (strcmp(argv[i], "-x") == 0) {
+            ok = parseOption(argv[++i], 0, 100, options.dropPercent);
+        } else if (strcmp(argv[i], "-R") == 0) {
+            ok = parseOption(argv[++i], 0, 60000, options.reconnectDelay);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "❌ Neplatný parametr: " << option << "\n" << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    options.threads = std::min(options.threads, options.connections);
+
+    std::cout << "🏁 Generátor zátěže: " << options.connections << " botů -> " << options.ip << ":"
+              << options.port << " (" << options.threads << " vláken, " << options.duration << " s";
+    if (options.dropPercent > 0) {
+        std::cout << ", výpadky " << options.dropPercent << " %";
+    }
+    std::cout << ")" << std::endl;
+
+    // Boti se rozdělí mezi vlákna round-robin, každé vlákno má vlastní epoll
+    std::vector<std::unique_ptr<Driver>> drivers;
+    for (int t = 0; t < options.threads; t++) {
+        std::vector<int> ids;
+        for (int id = t; id < options.connections; id += options.threads) {
+            ids.push_back(id);
+        }
+        drivers.push_back(std::make_unique<Driver>(options, std::move(ids)));
+    }
+
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (auto& driver : drivers) {
+        threads.emplace_back([&driver, &running] { driver->run(running); });
+    }
+
+    auto start = Clock::now();
+    auto end = start + std::chrono::seconds(options.duration);
+    uint64_t lastMessages = 0;
+    while (Clock::now() < end) {
+        std::this_thread::sleep_for(std::min<Clock::duration>(PROGRESS_INTERVAL, end - Clock::now()));
+
+        uint64_t games = 0, messages = 0, playing = 0;
+        for (const auto& driver : drivers) {
+            games += driver->getGames();
+            messages += driver->getMessages();
+            playing += driver->getPlaying();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "⏱️  " << std::fixed << std::setprecision(0) << elapsed << " s: hraje " << playing
+                  << " botů, hry " << games << ", zprávy "
+                  << (messages - lastMessages) / std::chrono::duration<double>(PROGRESS_INTERVAL).count()
+                  << "/s" << std::endl;
+        lastMessages = messages;
+    }
+
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Stats total;
+    for (const auto& driver : drivers) {
+        total.merge(driver->getStats());
+    }
+    printReport(options, total, std::chrono::duration<double>(Clock::now() - start).count());
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Mikrobenchmark serializace protokolu – porovnává původní serializaci přes
+// stringstream s novou serializací do znovupoužívaného bufferu a rozeslání
+// jedné zprávy více hráčům (celá zpráva pro každého vs. sdílená data + hlavička).
+//
+// Spuštění:  ./protocol_bench [počet_iterací]
+
+#include "server/Protocol.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Protocol;
+
+namespace {
+    // Původní implementace (před přechodem na to_chars) – slouží jako reference
+    std::string legacySerialize(const Message& msg) {
+        std::stringstream ss;
+
+        ss << static_cast<int>(msg.packetID) << DELIMITER
+           << static_cast<int>(msg.clientID) << DELIMITER
+           << static_cast<int>(msg.type);
+
+        for (const auto& field : msg.fields) {
+            ss << DELIMITER << field;
+        }
+        ss << TERMINATOR;
+
+        std::string content = ss.str();
+        uint16_t total_size = content.length() + 6;
+
+        std::stringstream final;
+        final << total_size << DELIMITER << content;
+        return final.str();
+    }
+
+    // Typický STATE rámec (stav hry, trumf, ruka hráče, karty na stole)
+    Message makeStateMessage() {
+        return Message(117, 2, MessageType::STATE,
+                       {"1", "2", "0", "1", "♥", "1",
+                        "a ♥:k ♥:10 ♥:8 ♥:q ♣:8 ♣:j ♠:", "7 ♦:9 ♦:", "1"});
+    }
+
+    // Typický GAME_START rámec (hráč, ruka, soupeři, počáteční stav)
+    Message makeGameStartMessage() {
+        return Message(8, 0, MessageType::GAME_START,
+                       {"0-alice", "a ♥:j ♦:8 ♦:a ♣:j ♣:a ♠:k ♠:10 ♣:9 ♣:7 ♠:",
+                        "1-bob:2-carol:", "0", "0"});
+    }
+
+    template <typename Fn>
+    double measure(const char* label, long iterations, Fn&& fn) {
+        size_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < iterations; i++) {
+            checksum += fn();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::cout << "   " << label << ": " << ns << " ns/zpráva (kontrola " << checksum << ")"
+                  << std::endl;
+        return ns;
+    }
+
+    bool benchMessage(const char* name, const Message& msg, long iterations) {
+        std::string buffer;
+        std::string legacy = legacySerialize(msg);
+        std::string_view current = serialize(msg, buffer);
+
+        std::cout << "📦 " << name << " (" << legacy.size() << " B)" << std::endl;
+        if (legacy != current) {
+            std::cerr << "❌ Výstupy se liší!" << std::endl
+                      << "   legacy: " << legacy
+                      << "   nový:   " << current;
+            return false;
+        }
+
+        double before = measure("stringstream     ", iterations,
+                                [&] { return legacySerialize(msg).size(); });
+        double after = measure("to_chars + buffer", iterations,
+                               [&] { return serialize(msg, buffer).size(); });
+        measure("to_chars -> string", iterations,
+                [&] { return serialize(msg).size(); });
+
+        std::cout << "   ⚡ Zrychlení: " << before / after << "x" << std::endl << std::endl;
+        return true;
+    }
+
+    bool benchFanOut(const char* name, const Message& msg, int recipients, long iterations) {
+        std::string buffer;
+        std::string headerBuffer;
+
+        // Hlavička + sdílená data musí dát stejný rámec jako celá zpráva
+        Payload payload = serializePayload(msg.fields);
+        std::string joined = std::string(serializeHeader(msg.packetID, msg.clientID, msg.type,
+                                                         payload->size(), headerBuffer)) + *payload;
+
+        std::cout << "📢 " << name << " -> " << recipients << " hráčů" << std::endl;
+        if (joined != serialize(msg, buffer)) {
+            std::cerr << "❌ Výstupy se liší!" << std::endl
+                      << "   celá zpráva: " << serialize(msg, buffer)
+                      << "   sdílená:     " << joined;
+            return false;
+        }
+
+        double before = measure("zpráva pro každého ", iterations, [&] {
+            size_t total = 0;
+            for (int i = 0; i < recipients; i++) {
+                Message copy = createMessage(msg.packetID, i, msg.type, msg.fields);
+                total += std::string(serialize(copy, buffer)).size();
+            }
+            return total;
+        });
+        double after = measure("data jednou + hlavička", iterations, [&] {
+            Payload shared = serializePayload(msg.fields);
+            size_t total = 0;
+            for (int i = 0; i < recipients; i++) {
+                std::string header(serializeHeader(msg.packetID, static_cast<uint8_t>(i), msg.type,
+                                                   shared->size(), headerBuffer));
+                total += header.size() + shared->size();
+            }
+            return total;
+        });
+
+        std::cout << "   ⚡ Zrychlení: " << before / after << "x" << std::endl << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (iterations <= 0) {
+        std::cerr << "Chyba: Počet iterací musí být kladné číslo" << std::endl;
+        return 1;
+    }
+
+    std::cout << "🏁 Benchmark serializace (" << iterations << " iterací)" << std::endl << std::endl;
+
+    bool ok = benchMessage("STATE", makeStateMessage(), iterations)
+           && benchMessage("GAME_START", makeGameStartMessage(), iterations)
+           && benchFanOut("STATE", makeStateMessage(), 3, iterations / 4);
+
+    return ok ? 0 : 1;
+}